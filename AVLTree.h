@@ -5,7 +5,26 @@
 #ifndef DS_WET2_WINTER_2026_01_AVLTREE_H
 #define DS_WET2_WINTER_2026_01_AVLTREE_H
 
-// Simple, robust AVL Tree with subtree-size (order statistics) + iterative clear().
+#include <type_traits> // std::is_trivially_destructible, std::is_empty
+
+#include "HuntechStats.h"
+#include "NodePool.h"
+
+// Simple, robust AVL Tree with subtree-size (order statistics).
+// Nodes live in a slab pool and link to each other by 32-bit handles,
+// so insert/remove reuse freed slots instead of calling new/delete,
+// and clear() drops whole slabs at once.
+//
+// Optional augmentation: the Aug policy is a monoid over in-order runs of
+// entries, kept per subtree next to subSize:
+//   typedef ... Summary;
+//   static Summary identity();
+//   static Summary of(const Key&, const Value&);
+//   static Summary combine(const Summary& left, const Summary& right);
+// combine must be associative; it need not be commutative (left is the
+// earlier run in key order). foldRanks()/foldRange() fold any contiguous
+// run in O(log n). The default NoAugment has an empty Summary, which takes
+// no space in the node and no work in recalc().
 // No STL containers.
 
 template <typename Key>
@@ -13,65 +32,179 @@ struct DefaultLess {
     bool operator()(const Key& a, const Key& b) const { return a < b; }
 };
 
-template <typename Key, typename Value, typename Less = DefaultLess<Key>>
+template <typename Key, typename Value>
+struct NoAugment {
+    struct Summary {};
+    static Summary identity() { return Summary(); }
+    static Summary of(const Key&, const Value&) { return Summary(); }
+    static Summary combine(const Summary&, const Summary&) { return Summary(); }
+};
+
+// Node storage for the subtree summary (empty base when Summary is empty).
+template <typename S, bool Empty = std::is_empty<S>::value>
+struct AVLSummarySlot {
+    S agg;
+
+    explicit AVLSummarySlot(const S& s) : agg(s) {}
+    const S& summary() const { return agg; }
+    void setSummary(const S& s) { agg = s; }
+};
+
+template <typename S>
+struct AVLSummarySlot<S, true> {
+    explicit AVLSummarySlot(const S&) {}
+    S summary() const { return S(); }
+    void setSummary(const S&) {}
+};
+
+template <typename Key, typename Value, typename Less = DefaultLess<Key>,
+          typename Aug = NoAugment<Key, Value>>
 class AVLTree {
 public:
-    struct Node {
+    typedef unsigned int Handle;
+    typedef typename Aug::Summary Summary;
+
+    struct Node : AVLSummarySlot<Summary> {
         Key key;
         Value value;
         int height;
         int subSize;   // subtree size for select(k)
-        Node* left;
-        Node* right;
+        Handle left;
+        Handle right;
 
         Node(const Key& k, const Value& v)
-            : key(k), value(v), height(1), subSize(1), left(nullptr), right(nullptr) {}
+            : AVLSummarySlot<Summary>(Aug::of(k, v)),
+              key(k), value(v), height(1), subSize(1), left(0), right(0) {}
     };
 
 private:
-    Node* root;
+    typedef NodePool<Node> Pool;
+    static const Handle NIL = Pool::NIL;
+
+    // An AVL tree with < 2^32 nodes is less than 1.45 * 32 levels deep.
+    static const int MAX_HEIGHT = 64;
+
+    Pool pool;
+    Handle root;
     Less less;
 
 private:
-    static int h(Node* n) { return n ? n->height : 0; }
-    static int sz(Node* n) { return n ? n->subSize : 0; }
+    Node& at(Handle n) { return pool.at(n); }
+    const Node& at(Handle n) const { return pool.at(n); }
+
+    int h(Handle n) const { return n ? at(n).height : 0; }
+    int sz(Handle n) const { return n ? at(n).subSize : 0; }
+    Summary agg(Handle n) const { return n ? at(n).summary() : Aug::identity(); }
     static int max2(int a, int b) { return (a > b) ? a : b; }
 
-    static void recalc(Node* n) {
+    void recalc(Handle n) {
         if (!n) return;
-        n->height  = 1 + max2(h(n->left), h(n->right));
-        n->subSize = 1 + sz(n->left) + sz(n->right);
+        Node& x = at(n);
+        x.height  = 1 + max2(h(x.left), h(x.right));
+        x.subSize = 1 + sz(x.left) + sz(x.right);
+        if (!std::is_empty<Summary>::value) {
+            x.setSummary(Aug::combine(Aug::combine(agg(x.left), Aug::of(x.key, x.value)),
+                                      agg(x.right)));
+        }
     }
 
-    static int balanceFactor(Node* n) {
-        return n ? (h(n->left) - h(n->right)) : 0;
+    // Fold of the entries of subtree n with in-subtree rank >= k (1-indexed).
+    Summary foldSuffixByRank(Handle n, int k) const {
+        Summary acc = Aug::identity();
+        while (n) {
+            const Node& x = at(n);
+            int leftSize = sz(x.left);
+            if (k <= leftSize + 1) {
+                // x and its right subtree are in, continue left
+                acc = Aug::combine(Aug::combine(Aug::of(x.key, x.value), agg(x.right)), acc);
+                n = x.left;
+            } else {
+                k -= (leftSize + 1);
+                n = x.right;
+            }
+        }
+        return acc;
     }
 
-    static Node* rotateRight(Node* y) {
-        Node* x = y->left;
-        Node* t2 = x->right;
+    // Fold of the entries of subtree n with in-subtree rank <= k.
+    Summary foldPrefixByRank(Handle n, int k) const {
+        Summary acc = Aug::identity();
+        while (n && k > 0) {
+            const Node& x = at(n);
+            int leftSize = sz(x.left);
+            if (k >= leftSize + 1) {
+                // x and its left subtree are in, continue right
+                acc = Aug::combine(Aug::combine(acc, agg(x.left)), Aug::of(x.key, x.value));
+                k -= (leftSize + 1);
+                n = x.right;
+            } else {
+                n = x.left;
+            }
+        }
+        return acc;
+    }
 
-        x->right = y;
-        y->left = t2;
+    // Fold of the entries of subtree n with key >= lo.
+    Summary foldSuffixByKey(Handle n, const Key& lo) const {
+        Summary acc = Aug::identity();
+        while (n) {
+            const Node& x = at(n);
+            if (!less(x.key, lo)) {
+                acc = Aug::combine(Aug::combine(Aug::of(x.key, x.value), agg(x.right)), acc);
+                n = x.left;
+            } else {
+                n = x.right;
+            }
+        }
+        return acc;
+    }
+
+    // Fold of the entries of subtree n with key <= hi.
+    Summary foldPrefixByKey(Handle n, const Key& hi) const {
+        Summary acc = Aug::identity();
+        while (n) {
+            const Node& x = at(n);
+            if (!less(hi, x.key)) {
+                acc = Aug::combine(Aug::combine(acc, agg(x.left)), Aug::of(x.key, x.value));
+                n = x.right;
+            } else {
+                n = x.left;
+            }
+        }
+        return acc;
+    }
+
+    int balanceFactor(Handle n) const {
+        return n ? (h(at(n).left) - h(at(n).right)) : 0;
+    }
+
+    Handle rotateRight(Handle y) {
+        HT_STAT_ADD(avlRotations, 1);
+        Handle x = at(y).left;
+        Handle t2 = at(x).right;
+
+        at(x).right = y;
+        at(y).left = t2;
 
         recalc(y);
         recalc(x);
         return x;
     }
 
-    static Node* rotateLeft(Node* x) {
-        Node* y = x->right;
-        Node* t2 = y->left;
+    Handle rotateLeft(Handle x) {
+        HT_STAT_ADD(avlRotations, 1);
+        Handle y = at(x).right;
+        Handle t2 = at(y).left;
 
-        y->left = x;
-        x->right = t2;
+        at(y).left = x;
+        at(x).right = t2;
 
         recalc(x);
         recalc(y);
         return y;
     }
 
-    Node* rebalance(Node* n) {
+    Handle rebalance(Handle n) {
         if (!n) return n;
 
         recalc(n);
@@ -79,16 +212,16 @@ private:
 
         // Left heavy
         if (bf > 1) {
-            if (balanceFactor(n->left) < 0) {
-                n->left = rotateLeft(n->left);
+            if (balanceFactor(at(n).left) < 0) {
+                at(n).left = rotateLeft(at(n).left);
             }
             return rotateRight(n);
         }
 
         // Right heavy
         if (bf < -1) {
-            if (balanceFactor(n->right) > 0) {
-                n->right = rotateRight(n->right);
+            if (balanceFactor(at(n).right) > 0) {
+                at(n).right = rotateRight(at(n).right);
             }
             return rotateLeft(n);
         }
@@ -96,16 +229,18 @@ private:
         return n;
     }
 
-    Node* insertRec(Node* n, const Key& key, const Value& value, bool& inserted) {
+    Handle insertRec(Handle n, const Key& key, const Value& value, bool& inserted) {
         if (!n) {
             inserted = true;
-            return new Node(key, value);
+            return pool.create(Node(key, value));
         }
 
-        if (less(key, n->key)) {
-            n->left = insertRec(n->left, key, value, inserted);
-        } else if (less(n->key, key)) {
-            n->right = insertRec(n->right, key, value, inserted);
+        if (less(key, at(n).key)) {
+            Handle l = insertRec(at(n).left, key, value, inserted);
+            at(n).left = l;
+        } else if (less(at(n).key, key)) {
+            Handle r = insertRec(at(n).right, key, value, inserted);
+            at(n).right = r;
         } else {
             inserted = false; // key exists
             return n;
@@ -114,90 +249,113 @@ private:
         return rebalance(n);
     }
 
-    static Node* minNode(Node* n) {
-        Node* cur = n;
-        while (cur && cur->left) cur = cur->left;
+    Handle minNode(Handle n) const {
+        Handle cur = n;
+        while (cur && at(cur).left) cur = at(cur).left;
         return cur;
     }
 
-    Node* removeRec(Node* n, const Key& key, bool& removed) {
+    Handle removeRec(Handle n, const Key& key, bool& removed) {
         if (!n) {
             removed = false;
-            return nullptr;
+            return NIL;
         }
 
-        if (less(key, n->key)) {
-            n->left = removeRec(n->left, key, removed);
-        } else if (less(n->key, key)) {
-            n->right = removeRec(n->right, key, removed);
+        if (less(key, at(n).key)) {
+            Handle l = removeRec(at(n).left, key, removed);
+            at(n).left = l;
+        } else if (less(at(n).key, key)) {
+            Handle r = removeRec(at(n).right, key, removed);
+            at(n).right = r;
         } else {
             // found
             removed = true;
 
             // 0 or 1 child
-            if (!n->left || !n->right) {
-                Node* child = n->left ? n->left : n->right;
-                delete n;
+            if (!at(n).left || !at(n).right) {
+                Handle child = at(n).left ? at(n).left : at(n).right;
+                pool.destroy(n);
                 return child;
             }
 
             // 2 children: replace with successor key/value
-            Node* succ = minNode(n->right);
-            n->key = succ->key;
-            n->value = succ->value;
+            Handle succ = minNode(at(n).right);
+            at(n).key = at(succ).key;
+            at(n).value = at(succ).value;
 
             bool dummy = false;
-            n->right = removeRec(n->right, succ->key, dummy);
+            Handle r = removeRec(at(n).right, at(n).key, dummy);
+            at(n).right = r;
         }
 
         return rebalance(n);
     }
 
-    Node* findRec(Node* n, const Key& key) const {
-        Node* cur = n;
+    Handle findRec(Handle n, const Key& key) const {
+        HT_STAT_ADD(avlSearches, 1);
+        Handle cur = n;
         while (cur) {
-            if (less(key, cur->key)) {
-                cur = cur->left;
-            } else if (less(cur->key, key)) {
-                cur = cur->right;
+            HT_STAT_ADD(avlSearchDepth, 1);
+            if (less(key, at(cur).key)) {
+                cur = at(cur).left;
+            } else if (less(at(cur).key, key)) {
+                cur = at(cur).right;
             } else {
                 return cur;
             }
         }
-        return nullptr;
+        return NIL;
     }
 
-    // Iterative destroy with no STL and no recursion.
-    // Repeatedly rotate left child up until no left, then delete and go right.
-    static void destroyIterative(Node* n) {
+    // Balanced subtree over sorted [lo, hi), O(hi - lo), recursion depth O(log n).
+    Handle buildRec(const Key* keys, const Value* values, int lo, int hi) {
+        if (lo >= hi) return NIL;
+        int mid = lo + (hi - lo) / 2;
+
+        Handle n = pool.create(Node(keys[mid], values[mid]));
+        Handle l = buildRec(keys, values, lo, mid);
+        Handle r = buildRec(keys, values, mid + 1, hi);
+        at(n).left = l;
+        at(n).right = r;
+        recalc(n);
+        return n;
+    }
+
+    // Iterative destroy with no STL and no recursion (only needed when
+    // Key/Value have destructors; otherwise the pool drops the slabs).
+    // Repeatedly rotate left child up until no left, then destroy and go right.
+    void destroyIterative(Handle n) {
         while (n) {
-            if (n->left) {
-                Node* l = n->left;
-                n->left = l->right;
-                l->right = n;
+            if (at(n).left) {
+                Handle l = at(n).left;
+                at(n).left = at(l).right;
+                at(l).right = n;
                 n = l;
             } else {
-                Node* r = n->right;
-                delete n;
+                Handle r = at(n).right;
+                pool.destroy(n);
                 n = r;
             }
         }
     }
 
 public:
-    AVLTree() : root(nullptr), less(Less()) {}
+    AVLTree() : pool(), root(NIL), less(Less()) {}
     ~AVLTree() { clear(); }
 
     AVLTree(const AVLTree&) = delete;
     AVLTree& operator=(const AVLTree&) = delete;
 
     void clear() {
-        destroyIterative(root);
-        root = nullptr;
+        if (!std::is_trivially_destructible<Node>::value) {
+            destroyIterative(root);
+        }
+        pool.releaseAll();
+        root = NIL;
     }
 
     int size() const { return sz(root); }
-    bool isEmpty() const { return root == nullptr; }
+    bool isEmpty() const { return root == NIL; }
 
     // returns false if key already exists
     bool insert(const Key& key, const Value& value) {
@@ -215,33 +373,297 @@ public:
 
     // returns pointer to value or nullptr
     Value* find(const Key& key) {
-        Node* n = findRec(root, key);
-        return n ? &n->value : nullptr;
+        Handle n = findRec(root, key);
+        return n ? &at(n).value : nullptr;
     }
 
     const Value* find(const Key& key) const {
-        Node* n = findRec(root, key);
-        return n ? &n->value : nullptr;
+        Handle n = findRec(root, key);
+        return n ? &at(n).value : nullptr;
+    }
+
+    // Replaces the content with n entries whose keys are strictly increasing,
+    // building the tree bottom-up in O(n). Returns false (tree left empty)
+    // if the keys are not strictly increasing.
+    bool buildFromSorted(const Key* keys, const Value* values, int n) {
+        clear();
+        for (int i = 1; i < n; i++) {
+            if (!less(keys[i - 1], keys[i])) return false;
+        }
+        root = buildRec(keys, values, 0, n);
+        return true;
+    }
+
+    // In-order visit f(key, value) with a bounded explicit stack (no recursion).
+    template <typename F>
+    void forEachInOrder(F f) const {
+        Handle stack[MAX_HEIGHT];
+        int top = 0;
+        Handle cur = root;
+        while (cur || top > 0) {
+            while (cur) {
+                stack[top++] = cur;
+                cur = at(cur).left;
+            }
+            cur = stack[--top];
+            f(at(cur).key, at(cur).value);
+            cur = at(cur).right;
+        }
+    }
+
+    // In-order cursor over a tree that is not modified while it is in use.
+    // Keeps the root-to-current path on a bounded stack, so next()/prev()
+    // cost amortized O(1) and a full scan visits every node a constant
+    // number of times.
+    class Cursor {
+    private:
+        const AVLTree* tree;
+        Handle path[MAX_HEIGHT];
+        int depth;   // path[0..depth) is root..current, 0 = past the end
+
+        const Node& node(Handle n) const { return tree->at(n); }
+
+        void descend(Handle n, bool leftmost) {
+            while (n) {
+                path[depth++] = n;
+                n = leftmost ? node(n).left : node(n).right;
+            }
+        }
+
+        // steps to the in-order neighbour on one side
+        void step(bool forward) {
+            Handle cur = path[depth - 1];
+            Handle side = forward ? node(cur).right : node(cur).left;
+            if (side) {
+                descend(side, forward);
+                return;
+            }
+            // climb while we come from that side
+            depth -= 1;
+            while (depth > 0) {
+                Handle parent = path[depth - 1];
+                Handle fromSide = forward ? node(parent).right : node(parent).left;
+                if (fromSide != cur) return;
+                cur = parent;
+                depth -= 1;
+            }
+        }
+
+    public:
+        explicit Cursor(const AVLTree* t) : tree(t), depth(0) {}
+
+        bool valid() const { return depth > 0; }
+        const Key& key() const { return node(path[depth - 1]).key; }
+        const Value& value() const { return node(path[depth - 1]).value; }
+
+        void next() { if (depth > 0) step(true); }
+        void prev() { if (depth > 0) step(false); }
+
+        // positions on the k-th key (1-indexed); invalid if out of range
+        void seek(int k) {
+            depth = 0;
+            if (k <= 0 || k > tree->size()) return;
+
+            Handle cur = tree->root;
+            while (cur) {
+                path[depth++] = cur;
+                int leftSize = tree->sz(node(cur).left);
+                if (k == leftSize + 1) return;
+                if (k <= leftSize) {
+                    cur = node(cur).left;
+                } else {
+                    k -= (leftSize + 1);
+                    cur = node(cur).right;
+                }
+            }
+        }
+
+        void seekFirst() {
+            depth = 0;
+            descend(tree->root, true);
+        }
+
+        void seekLast() {
+            depth = 0;
+            descend(tree->root, false);
+        }
+    };
+
+    // Cursor on the k-th key (1-indexed), invalid if k is out of range.
+    Cursor cursorAt(int k) const {
+        Cursor c(this);
+        c.seek(k);
+        return c;
     }
 
     // 1-indexed in-order select. nullptr if out of range.
     const Node* select(int k) const {
         if (k <= 0 || k > size()) return nullptr;
 
-        Node* cur = root;
+        HT_STAT_ADD(avlSearches, 1);
+        Handle cur = root;
         while (cur) {
-            int leftSize = sz(cur->left);
-            if (k == leftSize + 1) return cur;
+            HT_STAT_ADD(avlSearchDepth, 1);
+            int leftSize = sz(at(cur).left);
+            if (k == leftSize + 1) return &at(cur);
 
             if (k <= leftSize) {
-                cur = cur->left;
+                cur = at(cur).left;
             } else {
                 k -= (leftSize + 1);
-                cur = cur->right;
+                cur = at(cur).right;
             }
         }
         return nullptr;
     }
+
+    // Number of keys strictly less than key (0-indexed lower-bound position).
+    int countLess(const Key& key) const {
+        HT_STAT_ADD(avlSearches, 1);
+        int below = 0;
+        Handle cur = root;
+        while (cur) {
+            HT_STAT_ADD(avlSearchDepth, 1);
+            if (less(at(cur).key, key)) {
+                below += sz(at(cur).left) + 1;
+                cur = at(cur).right;
+            } else {
+                cur = at(cur).left;
+            }
+        }
+        return below;
+    }
+
+    // Number of keys less than or equal to key.
+    int countLessEqual(const Key& key) const {
+        HT_STAT_ADD(avlSearches, 1);
+        int below = 0;
+        Handle cur = root;
+        while (cur) {
+            HT_STAT_ADD(avlSearchDepth, 1);
+            if (less(key, at(cur).key)) {
+                cur = at(cur).left;
+            } else {
+                below += sz(at(cur).left) + 1;
+                cur = at(cur).right;
+            }
+        }
+        return below;
+    }
+
+    // 1-indexed in-order rank of key (inverse of select). 0 if not present.
+    int rank(const Key& key) const {
+        HT_STAT_ADD(avlSearches, 1);
+        int below = 0;
+        Handle cur = root;
+        while (cur) {
+            HT_STAT_ADD(avlSearchDepth, 1);
+            if (less(key, at(cur).key)) {
+                cur = at(cur).left;
+            } else if (less(at(cur).key, key)) {
+                below += sz(at(cur).left) + 1;
+                cur = at(cur).right;
+            } else {
+                return below + sz(at(cur).left) + 1;
+            }
+        }
+        return 0;
+    }
+
+    // Number of keys k with lo <= k <= hi.
+    int countInRange(const Key& lo, const Key& hi) const {
+        if (less(hi, lo)) return 0;
+        return countLessEqual(hi) - countLess(lo);
+    }
+
+    // Fold of every entry (the root summary). O(1).
+    Summary foldAll() const { return agg(root); }
+
+    // Fold of the entries at ranks i..j (1-indexed, inclusive, clamped to
+    // 1..size()); identity if the range is empty. O(log n).
+    Summary foldRanks(int i, int j) const {
+        if (i < 1) i = 1;
+        if (j > size()) j = size();
+        if (j < i) return Aug::identity();
+
+        HT_STAT_ADD(avlSearches, 1);
+        // descend to the highest node whose rank lies in [i, j]
+        Handle cur = root;
+        int before = 0;   // ranks to the left of cur's subtree
+        while (cur) {
+            HT_STAT_ADD(avlSearchDepth, 1);
+            const Node& x = at(cur);
+            int r = before + sz(x.left) + 1;
+            if (j < r) {
+                cur = x.left;
+            } else if (i > r) {
+                before = r;
+                cur = x.right;
+            } else {
+                Summary left = foldSuffixByRank(x.left, i - before);
+                Summary right = foldPrefixByRank(x.right, j - r);
+                return Aug::combine(Aug::combine(left, Aug::of(x.key, x.value)), right);
+            }
+        }
+        return Aug::identity();
+    }
+
+    // Fold of the entries with lo <= key <= hi. O(log n).
+    Summary foldRange(const Key& lo, const Key& hi) const {
+        if (less(hi, lo)) return Aug::identity();
+
+        HT_STAT_ADD(avlSearches, 1);
+        // descend to the highest node whose key lies in [lo, hi]
+        Handle cur = root;
+        while (cur) {
+            HT_STAT_ADD(avlSearchDepth, 1);
+            const Node& x = at(cur);
+            if (less(hi, x.key)) {
+                cur = x.left;
+            } else if (less(x.key, lo)) {
+                cur = x.right;
+            } else {
+                Summary left = foldSuffixByKey(x.left, lo);
+                Summary right = foldPrefixByKey(x.right, hi);
+                return Aug::combine(Aug::combine(left, Aug::of(x.key, x.value)), right);
+            }
+        }
+        return Aug::identity();
+    }
+
+    // First node with key >= key. nullptr if none.
+    const Node* lowerBound(const Key& key) const {
+        HT_STAT_ADD(avlSearches, 1);
+        Handle best = NIL;
+        Handle cur = root;
+        while (cur) {
+            HT_STAT_ADD(avlSearchDepth, 1);
+            if (less(at(cur).key, key)) {
+                cur = at(cur).right;
+            } else {
+                best = cur;
+                cur = at(cur).left;
+            }
+        }
+        return best ? &at(best) : nullptr;
+    }
+
+    // First node with key > key. nullptr if none.
+    const Node* upperBound(const Key& key) const {
+        HT_STAT_ADD(avlSearches, 1);
+        Handle best = NIL;
+        Handle cur = root;
+        while (cur) {
+            HT_STAT_ADD(avlSearchDepth, 1);
+            if (less(key, at(cur).key)) {
+                best = cur;
+                cur = at(cur).left;
+            } else {
+                cur = at(cur).right;
+            }
+        }
+        return best ? &at(best) : nullptr;
+    }
 };
 
 #endif //DS_WET2_WINTER_2026_01_AVLTREE_H
@@ -0,0 +1,17 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_DENSEINDEX_H
+#define DS_WET2_WINTER_2026_01_DENSEINDEX_H
+
+// Dense 32-bit indices into the hunter and squad stores (HunterStore.h,
+// SquadStore.h); the hash tables map external ids to them.
+
+typedef unsigned int HunterIndex;
+static const HunterIndex NO_HUNTER = 0xffffffffu;
+
+typedef unsigned int SquadIndex;
+static const SquadIndex NO_SQUAD = 0xffffffffu;
+
+#endif // DS_WET2_WINTER_2026_01_DENSEINDEX_H
@@ -7,108 +7,277 @@
 
 #include <new> // std::bad_alloc (optional to catch in your code)
 
+#include "HuntechStats.h"
+
+// Open-addressing hash table (Robin Hood linear probing).
+//
+// Layout:
+// - ctrl[i]  : one control byte per slot, 0 = empty, otherwise probe distance + 1
+// - slots[i] : key/value pairs, parallel to ctrl
+//
+// Capacity is always a power of two, so the home slot is (hash & mask).
+// Robin Hood keeps probe sequences short and lets find() stop as soon as it
+// meets a slot that is "richer" than the key would be, so a lookup usually
+// touches one control-byte line and one slot line.
+//
+// Growth is incremental: when the load factor is crossed, a table of twice
+// the size is allocated and the old one is kept next to it. Every insert then
+// migrates a bounded number of old slots, so no single insert pays O(n).
+// While a migration is in progress, lookups consult the new table first and
+// then the old one (entries are copied, never removed, from the old table,
+// so its probe sequences stay valid until it is dropped).
+//
+// Erase:
+// - in cur: backward-shift deletion (the following entries of the cluster
+//   move one slot back), so no tombstones and no lookup slow-down
+// - in old (an entry not migrated yet): the slot is only marked dead in a
+//   bitmap that lives as long as old; lookups ignore it and migration skips
+//   it, while the old probe sequences stay intact
+// No STL containers.
+
 template <typename Key, typename Value>
 class HashTable {
 private:
-    struct Node {
+    struct Slot {
         Key key;
         Value value;
-        Node* next;
+    };
+
+    static const unsigned long long MIN_CAPACITY = 16;
+    static const unsigned char MAX_DIST = 255;          // largest storable probe distance + 1
+    static const unsigned long long MIGRATE_STEP = 16;  // old slots moved per insert
+
+    struct Table {
+        unsigned char* ctrl;         // control bytes
+        Slot* slots;                 // key/value storage
+        unsigned long long capacity; // number of slots (power of two)
+        unsigned long long mask;     // capacity - 1
+
+        Table() : ctrl(nullptr), slots(nullptr), capacity(0), mask(0) {}
+
+        void allocate(unsigned long long cap) {
+            unsigned char* newCtrl = new unsigned char[cap];
+            Slot* newSlots = nullptr;
+            try {
+                newSlots = new Slot[cap];
+            } catch (...) {
+                delete[] newCtrl;
+                throw;
+            }
+            for (unsigned long long i = 0; i < cap; i++) newCtrl[i] = 0;
+
+            ctrl = newCtrl;
+            slots = newSlots;
+            capacity = cap;
+            mask = cap - 1;
+        }
+
+        void release() {
+            delete[] ctrl;
+            delete[] slots;
+            ctrl = nullptr;
+            slots = nullptr;
+            capacity = 0;
+            mask = 0;
+        }
 
-        Node(const Key& k, const Value& v, Node* n)
-            : key(k), value(v), next(n) {}
+        unsigned long long homeOf(const Key& key) const {
+            // Here Key is expected to be int in our wet usage.
+            return hashInt((unsigned long long)(unsigned int)key) & mask;
+        }
+
+        long long findIndex(const Key& key) const {
+            if (!ctrl) return -1;
+            HT_STAT_ADD(htLookups, 1);
+            unsigned long long i = homeOf(key);
+            unsigned char d = 1;
+            while (ctrl[i] >= d) {
+                HT_STAT_ADD(htProbes, 1);
+                if (ctrl[i] == d && slots[i].key == key) return (long long)i;
+                if (d == MAX_DIST) break;
+                d += 1;
+                i = (i + 1) & mask;
+            }
+            return -1;
+        }
+
+        // Backward-shift deletion of slot i.
+        void eraseAt(unsigned long long i) {
+            unsigned long long next = (i + 1) & mask;
+            while (ctrl[next] > 1) {
+                ctrl[i] = (unsigned char)(ctrl[next] - 1);
+                slots[i] = slots[next];
+                i = next;
+                next = (next + 1) & mask;
+            }
+            ctrl[i] = 0;
+        }
+
+        // Robin Hood placement of a key known to be absent.
+        // Returns false if some probe distance would overflow the control byte;
+        // key/value then hold the entry that is still homeless (it may be a
+        // displaced one), the rest of the table stays consistent.
+        bool place(Key& key, Value& value) {
+            unsigned long long i = homeOf(key);
+            unsigned char d = 1;
+
+            while (true) {
+                if (ctrl[i] == 0) {
+                    ctrl[i] = d;
+                    slots[i].key = key;
+                    slots[i].value = value;
+                    return true;
+                }
+                if (ctrl[i] < d) {
+                    // steal the slot from the richer entry and carry it forward
+                    unsigned char td = ctrl[i];
+                    Key tk = slots[i].key;
+                    Value tv = slots[i].value;
+                    ctrl[i] = d;
+                    slots[i].key = key;
+                    slots[i].value = value;
+                    d = td;
+                    key = tk;
+                    value = tv;
+                }
+                if (d == MAX_DIST) return false;
+                d += 1;
+                i = (i + 1) & mask;
+            }
+        }
     };
 
-    Node** buckets;      // array of heads
-    int capacity;        // number of buckets
-    int count;           // number of stored elements
+    Table cur;                   // table receiving all inserts
+    Table old;                   // table being drained (ctrl == nullptr if none)
+    unsigned long long cursor;   // next old slot to migrate
+    unsigned char* oldDead;      // bitmap of erased old slots (allocated on first erase)
+    long long count;             // number of stored elements
 
 private:
-    static unsigned int hashInt(unsigned int x) {
-        // A decent integer mixer (works fine for IDs)
-        x ^= x >> 16;
-        x *= 0x7feb352dU;
-        x ^= x >> 15;
-        x *= 0x846ca68bU;
-        x ^= x >> 16;
+    static unsigned long long hashInt(unsigned long long x) {
+        // 64-bit finalizer (splitmix64): good spread for sequential IDs
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
         return x;
     }
 
-    static int nextPrime(int minVal) {
-        // Fixed prime table (enough for wet constraints). Grows roughly x2.
-        static const int primes[] = {
-            17, 37, 79, 163, 331, 673, 1361, 2729, 5471, 10949, 21911, 43853,
-            87719, 175447, 350899, 701819, 1403641, 2807303, 5614657, 11229331,
-            22458671, 44917381, 89834777, 179669557
-        };
-        static const int P = (int)(sizeof(primes) / sizeof(primes[0]));
+    bool migrating() const { return old.ctrl != nullptr; }
 
-        for (int i = 0; i < P; i++) {
-            if (primes[i] >= minVal) return primes[i];
+    bool oldIsDead(unsigned long long i) const {
+        return oldDead && (oldDead[i >> 3] & (1u << (i & 7)));
+    }
+
+    void markOldDead(unsigned long long i) {
+        if (!oldDead) {
+            unsigned long long bytes = (old.capacity + 7) >> 3;
+            oldDead = new unsigned char[bytes];
+            for (unsigned long long b = 0; b < bytes; b++) oldDead[b] = 0;
         }
-        // If exceeded (very unlikely in wet), just return the last one.
-        return primes[P - 1];
+        oldDead[i >> 3] |= (unsigned char)(1u << (i & 7));
     }
 
-    int indexOfKey(const Key& key) const {
-        // Here Key is expected to be int in our wet usage.
-        unsigned int x = (unsigned int)key;
-        unsigned int h = hashInt(x);
-        return (int)(h % (unsigned int)capacity);
+    void dropOld() {
+        old.release();
+        delete[] oldDead;
+        oldDead = nullptr;
+        cursor = 0;
     }
 
-    void freeBuckets(Node** arr, int cap) {
-        if (!arr) return;
-        for (int i = 0; i < cap; i++) {
-            Node* cur = arr[i];
-            while (cur) {
-                Node* nxt = cur->next;
-                delete cur;
-                cur = nxt;
+    // Rebuilds cur with (at least) newCap slots in one pass.
+    void rehashCurrent(unsigned long long newCap) {
+        HT_STAT_TIME(htRehashNanos);
+        Table prev = cur;
+
+        while (true) {
+            cur.allocate(newCap);
+
+            bool ok = true;
+            for (unsigned long long i = 0; i < prev.capacity && ok; i++) {
+                if (prev.ctrl[i] == 0) continue;
+                Key k = prev.slots[i].key;
+                Value v = prev.slots[i].value;
+                ok = cur.place(k, v);
             }
+            if (ok) break;
+
+            // pathological clustering: try again with a bigger table
+            cur.release();
+            newCap *= 2;
         }
-        delete[] arr;
-    }
 
-    void rehash(int newCap) {
-        Node** newBuckets = new Node*[newCap];
-        for (int i = 0; i < newCap; i++) newBuckets[i] = nullptr;
+        prev.release();
+    }
 
-        // move nodes (recreate nodes; simplest + safest)
-        for (int i = 0; i < capacity; i++) {
-            Node* cur = buckets[i];
-            while (cur) {
-                Node* nxt = cur->next;
+    // Places an absent key into cur, growing cur in place on probe overflow.
+    void placeCurrent(const Key& key, const Value& value) {
+        Key k = key;
+        Value v = value;
+        while (!cur.place(k, v)) {
+            rehashCurrent(cur.capacity * 2);
+        }
+    }
 
-                int idx = (int)(hashInt((unsigned int)cur->key) % (unsigned int)newCap);
-                newBuckets[idx] = new Node(cur->key, cur->value, newBuckets[idx]);
+    // Moves up to `budget` old slots into cur; drops old when drained.
+    void migrateStep(unsigned long long budget) {
+        if (!migrating()) return;
+        HT_STAT_TIME(htRehashNanos);
 
-                delete cur;
-                cur = nxt;
+        while (budget > 0 && cursor < old.capacity) {
+            if (old.ctrl[cursor] != 0 && !oldIsDead(cursor)) {
+                placeCurrent(old.slots[cursor].key, old.slots[cursor].value);
+                HT_STAT_ADD(htMigratedSlots, 1);
             }
-            buckets[i] = nullptr;
+            cursor += 1;
+            budget -= 1;
         }
 
-        delete[] buckets;
-        buckets = newBuckets;
-        capacity = newCap;
-        // count stays the same
+        if (cursor == old.capacity) dropOld();
+    }
+
+    void finishMigration() {
+        if (migrating()) migrateStep(old.capacity);
     }
 
     void maybeGrow() {
         // load factor threshold ~ 0.75
-        if (count * 4 < capacity * 3) return;
-        int newCap = nextPrime(capacity * 2);
-        rehash(newCap);
+        if ((unsigned long long)count * 4 < cur.capacity * 3) return;
+
+        // a new migration may only start once the previous one is done
+        finishMigration();
+
+        HT_STAT_ADD(htGrowths, 1);
+        Table next;
+        next.allocate(cur.capacity * 2);
+        old = cur;
+        cur = next;
+        cursor = 0;
+    }
+
+    long long locate(const Key& key, const Table*& where) const {
+        long long i = cur.findIndex(key);
+        if (i >= 0) {
+            where = &cur;
+            return i;
+        }
+        if (migrating()) {
+            // entries below the cursor were already copied into cur
+            i = old.findIndex(key);
+            if (i >= 0 && (unsigned long long)i >= cursor && !oldIsDead((unsigned long long)i)) {
+                where = &old;
+                return i;
+            }
+        }
+        return -1;
     }
 
 public:
     HashTable()
-        : buckets(nullptr), capacity(0), count(0)
+        : cur(), old(), cursor(0), oldDead(nullptr), count(0)
     {
-        capacity = nextPrime(17);
-        buckets = new Node*[capacity];
-        for (int i = 0; i < capacity; i++) buckets[i] = nullptr;
+        cur.allocate(MIN_CAPACITY);
     }
 
     ~HashTable() {
@@ -119,55 +288,81 @@ public:
     HashTable& operator=(const HashTable&) = delete;
 
     void clear() {
-        freeBuckets(buckets, capacity);
-        buckets = nullptr;
-        capacity = 0;
+        cur.release();
+        dropOld();
         count = 0;
     }
 
-    int size() const { return count; }
+    // Pre-sizes the table so that n entries fit without any further growth
+    // (also makes a cleared table usable again).
+    void reserve(long long n) {
+        finishMigration();
+
+        unsigned long long cap = MIN_CAPACITY;
+        while (cap * 3 <= (unsigned long long)n * 4) cap *= 2;
+
+        if (!cur.ctrl) cur.allocate(cap);
+        else if (cap > cur.capacity) rehashCurrent(cap);
+    }
+
+    int size() const { return (int)count; }
     bool isEmpty() const { return count == 0; }
 
     // returns pointer to stored Value, or nullptr if not found
     Value* find(const Key& key) {
-        if (!buckets) return nullptr;
-        int idx = indexOfKey(key);
-        Node* cur = buckets[idx];
-        while (cur) {
-            if (cur->key == key) return &cur->value;
-            cur = cur->next;
-        }
-        return nullptr;
+        const Table* where = nullptr;
+        long long i = locate(key, where);
+        return (i < 0) ? nullptr : &where->slots[i].value;
     }
 
     const Value* find(const Key& key) const {
-        if (!buckets) return nullptr;
-        int idx = indexOfKey(key);
-        Node* cur = buckets[idx];
-        while (cur) {
-            if (cur->key == key) return &cur->value;
-            cur = cur->next;
-        }
-        return nullptr;
+        const Table* where = nullptr;
+        long long i = locate(key, where);
+        return (i < 0) ? nullptr : &where->slots[i].value;
     }
 
     // returns false if key already exists
     bool insert(const Key& key, const Value& value) {
-        if (!buckets) return false;
+        if (!cur.ctrl) return false;
 
-        int idx = indexOfKey(key);
-        Node* cur = buckets[idx];
-        while (cur) {
-            if (cur->key == key) return false;
-            cur = cur->next;
-        }
+        const Table* where = nullptr;
+        if (locate(key, where) >= 0) return false;
 
-        buckets[idx] = new Node(key, value, buckets[idx]);
+        placeCurrent(key, value);
         count += 1;
 
+        migrateStep(MIGRATE_STEP);
         maybeGrow();
         return true;
     }
+
+    // Visits every entry once as f(key, value), in no particular order.
+    template <typename F>
+    void forEach(F f) const {
+        for (unsigned long long i = 0; i < cur.capacity; i++) {
+            if (cur.ctrl[i] != 0) f(cur.slots[i].key, cur.slots[i].value);
+        }
+        if (!migrating()) return;
+        // entries below the cursor were already copied into cur
+        for (unsigned long long i = cursor; i < old.capacity; i++) {
+            if (old.ctrl[i] != 0 && !oldIsDead(i)) f(old.slots[i].key, old.slots[i].value);
+        }
+    }
+
+    // returns false if key does not exist
+    bool erase(const Key& key) {
+        const Table* where = nullptr;
+        long long i = locate(key, where);
+        if (i < 0) return false;
+
+        if (where == &cur) {
+            cur.eraseAt((unsigned long long)i);
+        } else {
+            markOldDead((unsigned long long)i);
+        }
+        count -= 1;
+        return true;
+    }
 };
 
 #endif // DS_WET2_WINTER_2026_01_HASHTABLE_H
@@ -1,14 +1,23 @@
 // You can edit anything you want in this file.
 // However, you need to implement all public Huntech functions, which are provided below as a template.
 
+#include <climits>
+
 #include "Huntech26a2.h"
+#include "HuntechStats.h"
+#include "ScratchArray.h"
 
 Huntech::Huntech()
     : squadsById(),
       squadsByAura(),
+      auraIndex(),
+      auraIndexOn(false),
+      auraIndexStale(false),
       huntersById(),
-      allSquads(nullptr),
-      allHunters(nullptr)
+      reclaimedFights(),
+      reclaimOn(false),
+      squadStore(),
+      hunterStore()
 {}
 
 Huntech::~Huntech() {
@@ -16,71 +25,170 @@ Huntech::~Huntech() {
 }
 
 void Huntech::freeAll() {
-    // Clear trees (deletes only tree nodes, not the Squad*/Hunter* themselves)
+    // Clear indexes (drops only their storage, not the squads/hunters themselves)
     squadsById.clear();
     squadsByAura.clear();
+    auraIndex.clear();
+    huntersById.clear();
+    reclaimedFights.clear();
 
-    // Delete allocated hunters
-    while (allHunters) {
-        HunterNode* n = allHunters;
-        allHunters = allHunters->next;
-        delete n->h;
-        delete n;
-    }
+    // Release all hunters and squads page by page
+    hunterStore.releaseAll();
+    squadStore.releaseAll();
+}
 
-    // Delete allocated squads
-    while (allSquads) {
-        SquadNode* n = allSquads;
-        allSquads = allSquads->next;
-        delete n->s;
-        delete n;
+void Huntech::resetToEmpty() {
+    freeAll();
+    try {
+        squadsById.reserve(0);
+        huntersById.reserve(0);
+        reclaimedFights.reserve(0);
+    } catch (const std::bad_alloc&) {
+        // a table left unusable makes later add_* calls report FAILURE
     }
 }
 
 // ---------- DSU helpers (with potentials) ----------
 
-Squad* Huntech::findSquad(Squad* x) {
-    if (!x) return nullptr;
-    if (!x->parent) return x;
-
-    Squad* p = x->parent;
-    Squad* r = findSquad(p);
+SquadIndex Huntech::findSquad(SquadIndex x) {
+    if (squadStore.node(x).parent == NO_SQUAD) return x;
+
+    // Pass 1: find the root and the total offset of x to it.
+    HT_STAT_ADD(dsuFinds, 1);
+    SquadIndex r = x;
+    int fightTotal = 0;
+    NenVec nenTotal = NenVec::zero();
+    while (squadStore.node(r).parent != NO_SQUAD) {
+        const DsuNode& n = squadStore.node(r);
+        HT_STAT_ADD(dsuHops, 1);
+        fightTotal += n.fightOffset;
+        nenTotal += n.nenOffset.unpack();
+        r = n.parent;
+    }
 
-    // Path compression with potential accumulation:
-    x->fightOffsetToParent += p->fightOffsetToParent;
-    x->nenOffsetToParent += p->nenOffsetToParent;
-    x->parent = r;
+    // Pass 2: hang every node on the path directly under the root.
+    // offset(y->root) = total - (offsets of the nodes below y on the path)
+    SquadIndex cur = x;
+    while (squadStore.node(cur).parent != r) {
+        DsuNode& n = squadStore.node(cur);
+        SquadIndex next = n.parent;
+        int oldFight = n.fightOffset;
+        NenVec oldNen = n.nenOffset.unpack();
+
+        n.fightOffset = fightTotal;
+        n.nenOffset = NenPacked::of(nenTotal);
+        n.parent = r;
+        HT_STAT_ADD(dsuCompressed, 1);
+
+        fightTotal -= oldFight;
+        nenTotal -= oldNen;
+        cur = next;
+    }
 
     return r;
 }
 
-int Huntech::fightPotential(Squad* x) {
-    Squad* r = findSquad(x);
-    // after compression, x->fightOffsetToParent is offset-to-root
-    return r->fightsAddRoot + x->fightOffsetToParent;
+int Huntech::fightPotential(SquadIndex x) {
+    SquadIndex r = findSquad(x);
+    // after compression, x's fightOffset is offset-to-root; the root's own
+    // field is its lazy term
+    if (x == r) return squadStore.node(r).fightOffset;
+    return squadStore.node(x).fightOffset + squadStore.node(r).fightOffset;
 }
 
-NenAbility Huntech::nenShiftToRoot(Squad* x) {
-    (void)findSquad(x);
-    // after compression, x->nenOffsetToParent is shift-to-root
-    return x->nenOffsetToParent;
+NenVec Huntech::nenShiftToRoot(SquadIndex x) {
+    SquadIndex r = findSquad(x);
+    // after compression, x's nenOffset is shift-to-root (see fightPotential)
+    if (x == r) return squadStore.node(r).nenOffset.unpack();
+    return squadStore.node(x).nenOffset.unpack() + squadStore.node(r).nenOffset.unpack();
+}
+
+SquadIndex Huntech::findSquadReadOnly(SquadIndex x, int& fightOffset,
+                                      NenVec& nenOffset) const {
+    fightOffset = 0;
+    nenOffset = NenVec::zero();
+    SquadIndex r = x;
+    while (true) {
+        const DsuNode& n = squadStore.node(r);
+        fightOffset += n.fightOffset;
+        nenOffset += n.nenOffset.unpack();
+        if (n.parent == NO_SQUAD) return r;
+        r = n.parent;
+    }
+}
+
+SquadIndex Huntech::linkSets(SquadIndex a, SquadIndex b) {
+    Squad& sa = squadStore.at(a);
+    Squad& sb = squadStore.at(b);
+    SquadIndex big = a;
+    SquadIndex small = b;
+    if (sb.setSize > sa.setSize) {
+        big = b;
+        small = a;
+    }
+
+    // Choose the offset so that (big root term + offset) equals the old root
+    // term of the small set, i.e. no hunter changes fights/prefix by linking.
+    DsuNode& sn = squadStore.node(small);
+    const DsuNode& bn = squadStore.node(big);
+    sn.fightOffset -= bn.fightOffset;
+    sn.nenOffset -= bn.nenOffset.unpack();
+    sn.parent = big;
+
+    squadStore.at(big).setSize += squadStore.at(small).setSize;
+
+    // hunter lists: a's hunters, then b's, now kept by the new root
+    HunterIndex last = (sb.lastHunter != NO_HUNTER) ? sb.lastHunter : sa.lastHunter;
+    if (sa.lastHunter != NO_HUNTER && sb.lastHunter != NO_HUNTER) {
+        HunterIndex firstOfA = hunterStore.next(sa.lastHunter);
+        hunterStore.next(sa.lastHunter) = hunterStore.next(sb.lastHunter);
+        hunterStore.next(sb.lastHunter) = firstOfA;
+    }
+    squadStore.at(small).lastHunter = NO_HUNTER;
+    squadStore.at(big).lastHunter = last;
+
+    // DSU node cycles: swapping one link of each merges them
+    SquadIndex t = sa.nextInSet;
+    sa.nextInSet = sb.nextInSet;
+    sb.nextInSet = t;
+    return big;
+}
+
+void Huntech::appendToSet(SquadIndex root, HunterIndex h) {
+    Squad& r = squadStore.at(root);
+    if (r.lastHunter != NO_HUNTER) {
+        hunterStore.next(h) = hunterStore.next(r.lastHunter);
+        hunterStore.next(r.lastHunter) = h;
+    } else {
+        hunterStore.next(h) = h;
+    }
+    r.lastHunter = h;
+}
+
+SquadDuelSide Huntech::duelSideOf(const Squad& r) {
+    SquadDuelSide side;
+    side.nenSum = r.nenSum.unpack();
+    side.auraSum = r.auraSum;
+    side.experience = r.experience;
+    side.huntersCount = r.huntersCount;
+    return side;
 }
 
 // ---------- Required API ----------
 
 StatusType Huntech::add_squad(int squadId) {
+    HT_STAT_API(API_ADD_SQUAD);
+
     if (squadId <= 0) return StatusType::INVALID_INPUT;
 
     try {
         if (squadsById.find(squadId) != nullptr) return StatusType::FAILURE;
 
-        Squad* s = new Squad(squadId);
-        allSquads = new SquadNode(s, allSquads);
+        SquadIndex s = squadStore.create(squadId);
 
         if (!squadsById.insert(squadId, s)) return StatusType::FAILURE;
 
-        AuraKey k(s->auraSum, s->id);
-        (void)squadsByAura.insert(k, s);
+        auraInsert(s);
 
         return StatusType::SUCCESS;
     } catch (const std::bad_alloc&) {
@@ -89,24 +197,28 @@ StatusType Huntech::add_squad(int squadId) {
 }
 
 StatusType Huntech::remove_squad(int squadId) {
+    HT_STAT_API(API_REMOVE_SQUAD);
+
     if (squadId <= 0) return StatusType::INVALID_INPUT;
 
     try {
-        Squad** ps = squadsById.find(squadId);
+        const SquadIndex* ps = squadsById.find(squadId);
         if (!ps) return StatusType::FAILURE;
 
-        Squad* s = *ps;
+        SquadIndex s = *ps;
 
         // remove from aura-rank tree
-        AuraKey key(s->auraSum, s->id);
-        (void)squadsByAura.remove(key);
+        auraRemove(s);
 
         // remove from id tree (active squads)
-        (void)squadsById.remove(squadId);
+        (void)squadsById.erase(squadId);
 
         // mark DSU root as dead (kills all hunters under it)
-        Squad* r = findSquad(s);
-        r->alive = false;
+        SquadIndex r = findSquad(s);
+        squadStore.at(r).alive = false;
+
+        // out of memory: the set stays (dead) for reclaim_dead_sets
+        if (reclaimOn) (void)reclaimSet(r);
 
         return StatusType::SUCCESS;
     } catch (const std::bad_alloc&) {
@@ -120,44 +232,56 @@ StatusType Huntech::add_hunter(int hunterId,
                                int aura,
                                int fightsHad)
 {
+    HT_STAT_API(API_ADD_HUNTER);
+
     if (hunterId <= 0 || squadId <= 0 || !nenType.isValid() || aura < 0 || fightsHad < 0) {
         return StatusType::INVALID_INPUT;
     }
 
     try {
         if (huntersById.find(hunterId) != nullptr) return StatusType::FAILURE;
+        if (!reclaimedFights.isEmpty() && reclaimedFights.find(hunterId) != nullptr) {
+            return StatusType::FAILURE;
+        }
 
-        Squad** ps = squadsById.find(squadId);
+        const SquadIndex* ps = squadsById.find(squadId);
         if (!ps) return StatusType::FAILURE;
 
-        Squad* s = *ps;
-        Squad* r = findSquad(s);
-        if (!r->alive) return StatusType::FAILURE;
-
-        // Update aura tree: remove old aura key for root
-        AuraKey oldKey(r->auraSum, r->id);
-        (void)squadsByAura.remove(oldKey);
+        SquadIndex r = findSquad(*ps);
+        Squad& squad = squadStore.at(r);
+        if (!squad.alive) return StatusType::FAILURE;
+        const DsuNode& root = squadStore.node(r);
 
         // base fights relative to current root lazy fights
-        int fightsNow = fightPotential(r); // r is root => fightsAddRoot
-        int baseF = fightsHad - fightsNow;
+        int baseF = fightsHad - root.fightOffset;
 
-        // local prefix at join time: current full nenSum (append at end)
-        NenAbility localPrefix = r->nenSum;
+        // the only NenAbility -> NenVec conversion on the way in
+        NenVec nen = NenVec::fromAbility(nenType);
 
-        Hunter* h = new Hunter(hunterId, nenType, aura, baseF, localPrefix, r);
-        allHunters = new HunterNode(h, allHunters);
+        // partial ability at join time: current full nenSum (append at end)
+        // plus the hunter's own, minus the root's lazy prefix that is added
+        // back on every query
+        NenVec partial = squad.nenSum.unpack() + nen - root.nenOffset.unpack();
 
-        if (!huntersById.insert(hunterId, h)) return StatusType::FAILURE;
+        // may grow the columns: done before the aura tree is touched
+        HunterIndex h = hunterStore.create(hunterId, aura, baseF, partial, r);
+
+        if (!huntersById.insert(hunterId, h)) {
+            hunterStore.destroy(h);
+            return StatusType::FAILURE;
+        }
+        appendToSet(r, h);
+
+        // Update aura tree: remove old aura key for root
+        auraRemove(r);
 
         // update squad aggregates
-        r->huntersCount += 1;
-        r->auraSum += (long long)aura;
-        r->nenSum += nenType;
+        squad.huntersCount += 1;
+        squad.auraSum += (long long)aura;
+        squad.nenSum += nen;
 
         // reinsert updated aura key
-        AuraKey newKey(r->auraSum, r->id);
-        (void)squadsByAura.insert(newKey, r);
+        auraInsert(r);
 
         return StatusType::SUCCESS;
     } catch (const std::bad_alloc&) {
@@ -166,49 +290,34 @@ StatusType Huntech::add_hunter(int hunterId,
 }
 
 output_t<int> Huntech::squad_duel(int squadId1, int squadId2) {
+    HT_STAT_API(API_SQUAD_DUEL);
+
     if (squadId1 <= 0 || squadId2 <= 0 || squadId1 == squadId2) {
         return output_t<int>(StatusType::INVALID_INPUT);
     }
 
     try {
-        Squad** p1 = squadsById.find(squadId1);
-        Squad** p2 = squadsById.find(squadId2);
+        const SquadIndex* p1 = squadsById.find(squadId1);
+        const SquadIndex* p2 = squadsById.find(squadId2);
         if (!p1 || !p2) return output_t<int>(StatusType::FAILURE);
 
-        Squad* s1 = findSquad(*p1);
-        Squad* s2 = findSquad(*p2);
-
-        if (!s1->alive || !s2->alive) return output_t<int>(StatusType::FAILURE);
-        if (s1->huntersCount == 0 || s2->huntersCount == 0) return output_t<int>(StatusType::FAILURE);
-
-        long long eff1 = (long long)s1->experience + s1->auraSum;
-        long long eff2 = (long long)s2->experience + s2->auraSum;
-
-        int res = 0;
-
-        if (eff1 > eff2) {
-            s1->experience += 3;
-            res = 1;
-        } else if (eff2 > eff1) {
-            s2->experience += 3;
-            res = 3;
-        } else {
-            if (s1->nenSum > s2->nenSum) {
-                s1->experience += 3;
-                res = 2;
-            } else if (s2->nenSum > s1->nenSum) {
-                s2->experience += 3;
-                res = 4;
-            } else {
-                s1->experience += 1;
-                s2->experience += 1;
-                res = 0;
-            }
-        }
+        SquadIndex r1 = findSquad(*p1);
+        SquadIndex r2 = findSquad(*p2);
+        Squad& s1 = squadStore.at(r1);
+        Squad& s2 = squadStore.at(r2);
+
+        if (!s1.alive || !s2.alive) return output_t<int>(StatusType::FAILURE);
+        if (s1.huntersCount == 0 || s2.huntersCount == 0) return output_t<int>(StatusType::FAILURE);
+
+        int gain1 = 0;
+        int gain2 = 0;
+        int res = duel_outcome(duelSideOf(s1), duelSideOf(s2), gain1, gain2);
+        s1.experience += gain1;
+        s2.experience += gain2;
 
         // every hunter in both squads fought +1 (lazy at root)
-        s1->fightsAddRoot += 1;
-        s2->fightsAddRoot += 1;
+        squadStore.node(r1).fightOffset += 1;
+        squadStore.node(r2).fightOffset += 1;
 
         return output_t<int>(res);
     } catch (const std::bad_alloc&) {
@@ -217,14 +326,19 @@ output_t<int> Huntech::squad_duel(int squadId1, int squadId2) {
 }
 
 output_t<int> Huntech::get_hunter_fights_number(int hunterId) {
+    HT_STAT_API(API_GET_HUNTER_FIGHTS);
+
     if (hunterId <= 0) return output_t<int>(StatusType::INVALID_INPUT);
 
     try {
-        Hunter** ph = huntersById.find(hunterId);
-        if (!ph) return output_t<int>(StatusType::FAILURE);
+        const HunterIndex* ph = huntersById.find(hunterId);
+        if (!ph) {
+            const int* fights = reclaimedFights.find(hunterId);
+            return fights ? output_t<int>(*fights) : output_t<int>(StatusType::FAILURE);
+        }
 
-        Hunter* h = *ph;
-        int fights = h->baseFights + fightPotential(h->blockSquad);
+        HunterIndex h = *ph;
+        int fights = hunterStore.baseFights(h) + fightPotential(hunterStore.block(h));
         return output_t<int>(fights);
     } catch (const std::bad_alloc&) {
         return output_t<int>(StatusType::ALLOCATION_ERROR);
@@ -232,116 +346,513 @@ output_t<int> Huntech::get_hunter_fights_number(int hunterId) {
 }
 
 output_t<int> Huntech::get_squad_experience(int squadId) {
+    HT_STAT_API(API_GET_SQUAD_EXPERIENCE);
+
     if (squadId <= 0) return output_t<int>(StatusType::INVALID_INPUT);
 
     try {
-        Squad** ps = squadsById.find(squadId);
+        const SquadIndex* ps = squadsById.find(squadId);
         if (!ps) return output_t<int>(StatusType::FAILURE);
 
-        Squad* r = findSquad(*ps);
-        if (!r->alive) return output_t<int>(StatusType::FAILURE);
+        const Squad& r = squadStore.at(findSquad(*ps));
+        if (!r.alive) return output_t<int>(StatusType::FAILURE);
 
-        return output_t<int>(r->experience);
+        return output_t<int>(r.experience);
     } catch (const std::bad_alloc&) {
         return output_t<int>(StatusType::ALLOCATION_ERROR);
     }
 }
 
 output_t<int> Huntech::get_ith_collective_aura_squad(int i) {
+    HT_STAT_API(API_GET_ITH_AURA_SQUAD);
+
     try {
         int n = squadsByAura.size();
         if (i < 1 || i > n) return output_t<int>(StatusType::FAILURE);
 
-        const AVLTree<AuraKey, Squad*, AuraKeyLess>::Node* node = squadsByAura.select(i);
+        const AuraTree::Node* node = squadsByAura.select(i);
         if (!node) return output_t<int>(StatusType::FAILURE);
 
-        return output_t<int>(node->value->id);
+        return output_t<int>(squadStore.at(node->value).id);
     } catch (const std::bad_alloc&) {
         return output_t<int>(StatusType::ALLOCATION_ERROR);
     }
 }
 
 output_t<NenAbility> Huntech::get_partial_nen_ability(int hunterId) {
+    HT_STAT_API(API_GET_PARTIAL_NEN);
+
     if (hunterId <= 0) return output_t<NenAbility>(StatusType::INVALID_INPUT);
 
     try {
-        Hunter** ph = huntersById.find(hunterId);
+        const HunterIndex* ph = huntersById.find(hunterId);
         if (!ph) return output_t<NenAbility>(StatusType::FAILURE);
 
-        Hunter* h = *ph;
+        HunterIndex h = *ph;
+        SquadIndex block = hunterStore.block(h);
 
-        Squad* r = findSquad(h->blockSquad);
-        if (!r->alive) return output_t<NenAbility>(StatusType::FAILURE);
+        SquadIndex r = findSquad(block);
+        if (!squadStore.at(r).alive) return output_t<NenAbility>(StatusType::FAILURE);
 
-        NenAbility shift = nenShiftToRoot(h->blockSquad);
-        NenAbility ans = h->localPrefixAtJoin + shift + h->ability;
+        NenVec shift = nenShiftToRoot(block);
+        NenVec ans = hunterStore.partial(h) + shift;
 
-        return output_t<NenAbility>(ans);
+        return output_t<NenAbility>(ans.toAbility());
     } catch (const std::bad_alloc&) {
         return output_t<NenAbility>(StatusType::ALLOCATION_ERROR);
     }
 }
 
 StatusType Huntech::force_join(int forcingSquadId, int forcedSquadId) {
+    HT_STAT_API(API_FORCE_JOIN);
+
     if (forcingSquadId <= 0 || forcedSquadId <= 0 || forcingSquadId == forcedSquadId) {
         return StatusType::INVALID_INPUT;
     }
 
     try {
-        Squad** pA = squadsById.find(forcingSquadId);
-        Squad** pB = squadsById.find(forcedSquadId);
+        const SquadIndex* pA = squadsById.find(forcingSquadId);
+        const SquadIndex* pB = squadsById.find(forcedSquadId);
         if (!pA || !pB) return StatusType::FAILURE;
 
-        Squad* A = findSquad(*pA);
-        Squad* B = findSquad(*pB);
+        SquadIndex rA = findSquad(*pA);
+        SquadIndex rB = findSquad(*pB);
+        Squad& A = squadStore.at(rA);
+        Squad& B = squadStore.at(rB);
 
-        if (!A->alive || !B->alive) return StatusType::FAILURE;
+        if (!A.alive || !B.alive) return StatusType::FAILURE;
+        if (!force_join_allowed(duelSideOf(A), duelSideOf(B))) return StatusType::FAILURE;
 
-        // forcing squad cannot be empty
-        if (A->huntersCount == 0) return StatusType::FAILURE;
+        // remove both from aura tree before changing A's aura
+        auraRemove(rA);
+        auraRemove(rB);
 
-        // If B is not empty, must satisfy the force condition
-        if (B->huntersCount != 0) {
-            long long left  = (long long)A->experience + A->auraSum + (long long)A->effectiveNen();
-            long long right = (long long)B->experience + B->auraSum + (long long)B->effectiveNen();
-            if (!(left > right)) return StatusType::FAILURE;
+        // Chronological order: all A hunters precede all B hunters
+        // so the whole B set gets an additional prefix = current nenSum(A)
+        squadStore.node(rB).nenOffset += A.nenSum.unpack();
+
+        // DSU union by size; the merged set keeps A's identity
+        SquadIndex rR = linkSets(rA, rB);
+        Squad& R = squadStore.at(rR);
+
+        R.id = forcingSquadId;
+        R.experience = A.experience + B.experience;
+        R.huntersCount = A.huntersCount + B.huntersCount;
+        R.auraSum = A.auraSum + B.auraSum;
+        R.nenSum = NenPacked::of(A.nenSum.unpack() + B.nenSum.unpack());
+
+        // forced squad is removed from active-id structure,
+        // forcing squad id now maps to the merged root
+        (void)squadsById.erase(forcedSquadId);
+        SquadIndex* pR = squadsById.find(forcingSquadId);
+        if (pR) *pR = rR;
+
+        // insert merged set into aura tree
+        auraInsert(rR);
+
+        return StatusType::SUCCESS;
+    } catch (const std::bad_alloc&) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+}
+
+// ---------- Extensions ----------
+
+output_t<int> Huntech::get_squad_aura_rank(int squadId) {
+    if (squadId <= 0) return output_t<int>(StatusType::INVALID_INPUT);
+
+    const SquadIndex* ps = squadsById.find(squadId);
+    if (!ps) return output_t<int>(StatusType::FAILURE);
+
+    // an active squad's aura key is held by its DSU root
+    const Squad& r = squadStore.at(findSquad(*ps));
+    int k = squadsByAura.rank(AuraKey(r.auraSum, r.id));
+    if (k == 0) return output_t<int>(StatusType::FAILURE);
+    return output_t<int>(k);
+}
+
+output_t<int> Huntech::count_squads_in_aura_range(long long minAura, long long maxAura) {
+    if (minAura > maxAura) return output_t<int>(StatusType::INVALID_INPUT);
+
+    // (aura, INT_MIN) .. (aura, INT_MAX) covers every squad id of an aura
+    AuraKey lo(minAura, INT_MIN);
+    AuraKey hi(maxAura, INT_MAX);
+    return output_t<int>(squadsByAura.countInRange(lo, hi));
+}
+
+output_t<int> Huntech::get_aura_squads_range(int i, int j, int* out) {
+    if (!out || i < 1 || j < i) return output_t<int>(StatusType::INVALID_INPUT);
+    if (j > squadsByAura.size()) return output_t<int>(StatusType::FAILURE);
+
+    AuraTree::Cursor c = squadsByAura.cursorAt(i);
+    int n = 0;
+    for (int k = i; k <= j; k++, c.next()) out[n++] = squadStore.at(c.value()).id;
+    return output_t<int>(n);
+}
+
+output_t<long long> Huntech::get_top_squads_aura_sum(int k) {
+    if (k < 1) return output_t<long long>(StatusType::INVALID_INPUT);
+
+    int n = squadsByAura.size();
+    if (k > n) return output_t<long long>(StatusType::FAILURE);
+    return output_t<long long>(squadsByAura.foldRanks(n - k + 1, n));
+}
+
+output_t<long long> Huntech::get_aura_band_sum(long long minAura, long long maxAura) {
+    if (minAura > maxAura) return output_t<long long>(StatusType::INVALID_INPUT);
+
+    AuraKey lo(minAura, INT_MIN);
+    AuraKey hi(maxAura, INT_MAX);
+    return output_t<long long>(squadsByAura.foldRange(lo, hi));
+}
+
+// ---------- Read-only queries (no path compression) ----------
+
+output_t<int> Huntech::peek_hunter_fights_number(int hunterId) const {
+    if (hunterId <= 0) return output_t<int>(StatusType::INVALID_INPUT);
+
+    const HunterIndex* ph = huntersById.find(hunterId);
+    if (!ph) {
+        const int* fights = reclaimedFights.find(hunterId);
+        return fights ? output_t<int>(*fights) : output_t<int>(StatusType::FAILURE);
+    }
+
+    HunterIndex h = *ph;
+    int fightOffset;
+    NenVec nenOffset;
+    (void)findSquadReadOnly(hunterStore.block(h), fightOffset, nenOffset);
+    return output_t<int>(hunterStore.baseFights(h) + fightOffset);
+}
+
+output_t<int> Huntech::peek_squad_experience(int squadId) const {
+    if (squadId <= 0) return output_t<int>(StatusType::INVALID_INPUT);
+
+    const SquadIndex* ps = squadsById.find(squadId);
+    if (!ps) return output_t<int>(StatusType::FAILURE);
+
+    int fightOffset;
+    NenVec nenOffset;
+    const Squad& r = squadStore.at(findSquadReadOnly(*ps, fightOffset, nenOffset));
+    if (!r.alive) return output_t<int>(StatusType::FAILURE);
+    return output_t<int>(r.experience);
+}
+
+output_t<int> Huntech::peek_ith_collective_aura_squad(int i) const {
+    if (i < 1 || i > squadsByAura.size()) return output_t<int>(StatusType::FAILURE);
+
+    const AuraTree::Node* node = squadsByAura.select(i);
+    if (!node) return output_t<int>(StatusType::FAILURE);
+    return output_t<int>(squadStore.at(node->value).id);
+}
+
+output_t<NenAbility> Huntech::peek_partial_nen_ability(int hunterId) const {
+    if (hunterId <= 0) return output_t<NenAbility>(StatusType::INVALID_INPUT);
+
+    const HunterIndex* ph = huntersById.find(hunterId);
+    if (!ph) return output_t<NenAbility>(StatusType::FAILURE);
+
+    HunterIndex h = *ph;
+    int fightOffset;
+    NenVec nenOffset;
+    SquadIndex r = findSquadReadOnly(hunterStore.block(h), fightOffset, nenOffset);
+    if (!squadStore.at(r).alive) return output_t<NenAbility>(StatusType::FAILURE);
+
+    NenVec ans = hunterStore.partial(h) + nenOffset;
+    return output_t<NenAbility>(ans.toAbility());
+}
+
+void Huntech::compress_paths() {
+    squadStore.forEach([this](SquadIndex s) { (void)findSquad(s); });
+}
+
+// ---------- Sharded front-end hooks ----------
+
+output_t<long long> Huntech::get_squad_collective_aura(int squadId) {
+    if (squadId <= 0) return output_t<long long>(StatusType::INVALID_INPUT);
+
+    const SquadIndex* ps = squadsById.find(squadId);
+    if (!ps) return output_t<long long>(StatusType::FAILURE);
+    return output_t<long long>(squadStore.at(findSquad(*ps)).auraSum);
+}
+
+output_t<int> Huntech::count_squads_before(long long aura, int squadId) {
+    return output_t<int>(squadsByAura.countLess(AuraKey(aura, squadId)));
+}
+
+output_t<SquadDuelSide> Huntech::get_duel_side(int squadId) {
+    if (squadId <= 0) return output_t<SquadDuelSide>(StatusType::INVALID_INPUT);
+
+    const SquadIndex* ps = squadsById.find(squadId);
+    if (!ps) return output_t<SquadDuelSide>(StatusType::FAILURE);
+    return output_t<SquadDuelSide>(duelSideOf(squadStore.at(findSquad(*ps))));
+}
+
+int Huntech::duel_outcome(const SquadDuelSide& a, const SquadDuelSide& b,
+                          int& gainA, int& gainB) {
+    long long effA = (long long)a.experience + a.auraSum;
+    long long effB = (long long)b.experience + b.auraSum;
+
+    gainA = 0;
+    gainB = 0;
+    if (effA > effB) {
+        gainA = 3;
+        return 1;
+    }
+    if (effB > effA) {
+        gainB = 3;
+        return 3;
+    }
+    if (a.nenSum > b.nenSum) {
+        gainA = 3;
+        return 2;
+    }
+    if (b.nenSum > a.nenSum) {
+        gainB = 3;
+        return 4;
+    }
+    gainA = 1;
+    gainB = 1;
+    return 0;
+}
+
+bool Huntech::force_join_allowed(const SquadDuelSide& forcing, const SquadDuelSide& forced) {
+    // forcing squad cannot be empty
+    if (forcing.huntersCount == 0) return false;
+
+    // If the forced squad is not empty, must satisfy the force condition
+    if (forced.huntersCount == 0) return true;
+    long long left  = (long long)forcing.experience + forcing.auraSum + (long long)forcing.nenSum.effective();
+    long long right = (long long)forced.experience + forced.auraSum + (long long)forced.nenSum.effective();
+    return left > right;
+}
+
+StatusType Huntech::apply_duel_result(int squadId, int experienceGain) {
+    if (squadId <= 0) return StatusType::INVALID_INPUT;
+
+    const SquadIndex* ps = squadsById.find(squadId);
+    if (!ps) return StatusType::FAILURE;
+
+    SquadIndex r = findSquad(*ps);
+    squadStore.at(r).experience += experienceGain;
+    squadStore.node(r).fightOffset += 1;
+    return StatusType::SUCCESS;
+}
+
+StatusType Huntech::export_squad(int squadId, SquadTransfer& out) {
+    if (squadId <= 0) return StatusType::INVALID_INPUT;
+
+    try {
+        const SquadIndex* ps = squadsById.find(squadId);
+        if (!ps) return StatusType::FAILURE;
+
+        SquadIndex r = findSquad(*ps);
+        out.reset(squadStore.at(r).huntersCount);
+        out.squadId = squadId;
+        out.experience = squadStore.at(r).experience;
+
+        // in join order each hunter's prefix is the previous partial ability
+        int k = 0;
+        NenVec prefix = NenVec::zero();
+        forEachHunterInSet(r, [&](HunterIndex h) {
+            TransferHunter& t = out.hunters[k++];
+            SquadIndex block = hunterStore.block(h);
+            t.id = hunterStore.id(h);
+            t.aura = hunterStore.aura(h);
+            t.fights = hunterStore.baseFights(h) + fightPotential(block);
+            NenVec partial = hunterStore.partial(h) + nenShiftToRoot(block);
+            NenVec ability = partial - prefix;
+            for (int i = 0; i < 6; i++) {
+                t.ability[i] = ability.c[i];
+                t.prefix[i] = prefix.c[i];
+            }
+            prefix = partial;
+        });
+
+        // the set leaves this instance; without reclamation its objects stay
+        // in the stores, unreachable (a detached block keeps hunters out of
+        // snapshots)
+        auraRemove(r);
+        (void)squadsById.erase(squadId);
+        forEachHunterInSet(r, [this](HunterIndex h) {
+            (void)huntersById.erase(hunterStore.id(h));
+            hunterStore.block(h) = NO_SQUAD;
+        });
+        squadStore.at(r).alive = false;
+        squadStore.at(r).huntersCount = 0;   // as many as a snapshot keeps
+        if (reclaimOn) freeSet(r);
+        return StatusType::SUCCESS;
+    } catch (const std::bad_alloc&) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+}
+
+StatusType Huntech::import_squad(const SquadTransfer& in) {
+    if (in.squadId <= 0 || in.hunterCount < 0) return StatusType::INVALID_INPUT;
+
+    try {
+        if (squadsById.find(in.squadId) != nullptr) return StatusType::FAILURE;
+        for (int k = 0; k < in.hunterCount; k++) {
+            int id = in.hunters[k].id;
+            if (id <= 0 || huntersById.find(id) != nullptr) return StatusType::FAILURE;
+            if (!reclaimedFights.isEmpty() && reclaimedFights.find(id) != nullptr) {
+                return StatusType::FAILURE;
+            }
         }
 
-        // remove both from aura tree before changing A's aura
-        AuraKey keyA(A->auraSum, A->id);
-        AuraKey keyB(B->auraSum, B->id);
-        (void)squadsByAura.remove(keyA);
-        (void)squadsByAura.remove(keyB);
+        // a fresh root has no lazy terms: baseFights is the fight count and
+        // the stored partial ability is prefix + ability
+        hunterStore.reserve((long long)hunterStore.size() + in.hunterCount);
+        SquadIndex s = squadStore.create(in.squadId);
+        Squad& squad = squadStore.at(s);
+        squad.experience = in.experience;
+        for (int k = 0; k < in.hunterCount; k++) {
+            const TransferHunter& t = in.hunters[k];
+            NenVec ability = NenVec::zero();
+            NenVec prefix = NenVec::zero();
+            for (int i = 0; i < 6; i++) {
+                ability.c[i] = t.ability[i];
+                prefix.c[i] = t.prefix[i];
+            }
+            HunterIndex h = hunterStore.create(t.id, t.aura, t.fights, prefix + ability, s);
+            (void)huntersById.insert(t.id, h);
+            appendToSet(s, h);
 
-        // DSU directed union: B becomes child of A
+            squad.huntersCount += 1;
+            squad.auraSum += (long long)t.aura;
+            squad.nenSum += ability;
+        }
 
-        // Preserve fights for hunters in B:
-        // old fights added for B-set was B->fightsAddRoot
-        // new fights added will be A->fightsAddRoot + fightOffsetToParent
-        // choose offset so equality holds:
-        B->fightOffsetToParent = B->fightsAddRoot - A->fightsAddRoot;
+        (void)squadsById.insert(in.squadId, s);
+        auraInsert(s);
+        return StatusType::SUCCESS;
+    } catch (const std::bad_alloc&) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+}
 
-        // Chronological order: all A hunters precede all B hunters
-        // so B block gets an additional prefix = current nenSum(A)
-        B->nenOffsetToParent = A->nenSum;
+// ---------- Aura-order snapshots ----------
 
-        B->parent = A;
+void Huntech::auraInsert(SquadIndex s) {
+    const Squad& squad = squadStore.at(s);
+    AuraKey k(squad.auraSum, squad.id);
+    (void)squadsByAura.insert(k, s);
+    if (!auraIndexOn || auraIndexStale) return;
+    try {
+        (void)auraIndex.insert(k, squad.id);
+    } catch (const std::bad_alloc&) {
+        auraIndexStale = true;
+    }
+}
 
-        // merge aggregates into A
-        A->experience += B->experience;
-        A->huntersCount += B->huntersCount;
-        A->auraSum += B->auraSum;
-        A->nenSum += B->nenSum;
+void Huntech::auraRemove(SquadIndex s) {
+    const Squad& squad = squadStore.at(s);
+    AuraKey k(squad.auraSum, squad.id);
+    (void)squadsByAura.remove(k);
+    if (!auraIndexOn || auraIndexStale) return;
+    try {
+        (void)auraIndex.remove(k);
+    } catch (const std::bad_alloc&) {
+        auraIndexStale = true;
+    }
+}
 
-        // forced squad is removed from active-id structure
-        (void)squadsById.remove(forcedSquadId);
+void Huntech::auraIndexRebuild() {
+    if (!auraIndexOn) return;
+    auraIndexStale = true;
+    try {
+        const int n = squadsByAura.size();
+        ScratchArray<AuraKey> keys(n);
+        ScratchArray<int> ids(n);
+        int k = 0;
+        squadsByAura.forEachInOrder([&](const AuraKey& key, const SquadIndex&) {
+            keys[k] = key;
+            ids[k] = key.squadId;
+            k += 1;
+        });
+        (void)auraIndex.buildFromSorted(keys.data(), ids.data(), n);
+        auraIndexStale = false;
+    } catch (const std::bad_alloc&) {
+        // stays stale; the next take_aura_snapshot retries
+    }
+}
 
-        // insert updated A into aura tree
-        AuraKey newKey(A->auraSum, A->id);
-        (void)squadsByAura.insert(newKey, A);
+StatusType Huntech::enable_aura_snapshots() {
+    if (auraIndexOn) return StatusType::SUCCESS;
+    auraIndexOn = true;
+    auraIndexRebuild();
+    if (auraIndexStale) {
+        auraIndexOn = false;
+        auraIndexStale = false;
+        auraIndex.clear();
+        return StatusType::ALLOCATION_ERROR;
+    }
+    return StatusType::SUCCESS;
+}
 
+StatusType Huntech::take_aura_snapshot(AuraSnapshot& out) {
+    if (!auraIndexOn) return StatusType::FAILURE;
+    if (auraIndexStale) {
+        auraIndexRebuild();
+        if (auraIndexStale) return StatusType::ALLOCATION_ERROR;
+    }
+    try {
+        out = auraIndex.snapshot();
         return StatusType::SUCCESS;
     } catch (const std::bad_alloc&) {
         return StatusType::ALLOCATION_ERROR;
     }
 }
+
+// ---------- Memory reclamation ----------
+
+bool Huntech::reclaimSet(SquadIndex r) {
+    // room for every moving hunter first, so the set is either moved whole
+    // or left untouched (a set with some hunters detached cannot be saved)
+    long long moving = 0;
+    forEachHunterInSet(r, [&](HunterIndex h) {
+        if (hunterStore.block(h) != NO_SQUAD) moving++;   // else exported
+    });
+    try {
+        reclaimedFights.reserve(reclaimedFights.size() + moving);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+
+    // fights first: an id that left huntersById is always answered here
+    forEachHunterInSet(r, [this](HunterIndex h) {
+        SquadIndex block = hunterStore.block(h);
+        if (block == NO_SQUAD) return;
+        int id = hunterStore.id(h);
+        (void)reclaimedFights.insert(id, hunterStore.baseFights(h) + fightPotential(block));
+        (void)huntersById.erase(id);
+        hunterStore.block(h) = NO_SQUAD;
+    });
+    freeSet(r);
+    return true;
+}
+
+void Huntech::freeSet(SquadIndex r) {
+    forEachHunterInSet(r, [this](HunterIndex h) { hunterStore.destroy(h); });
+    SquadIndex s = r;
+    do {
+        SquadIndex next = squadStore.at(s).nextInSet;
+        squadStore.destroy(s);
+        s = next;
+    } while (s != r);
+}
+
+void Huntech::enable_reclamation() {
+    reclaimOn = true;
+}
+
+output_t<int> Huntech::reclaim_dead_sets() {
+    const int before = squadStore.size() + hunterStore.size();
+    bool ok = true;
+    squadStore.forEach([&](SquadIndex s) {
+        if (squadStore.node(s).parent == NO_SQUAD && !squadStore.at(s).alive && !reclaimSet(s)) {
+            ok = false;
+        }
+    });
+    if (!ok) return output_t<int>(StatusType::ALLOCATION_ERROR);
+    return output_t<int>(before - (squadStore.size() + hunterStore.size()));
+}
@@ -15,50 +15,109 @@
 #include "wet2util.h"
 
 #include "AVLTree.h"
+#include "PersistentAVLTree.h"
 #include "Keys.h"
-#include "Squad.h"
-#include "Hunter.h"
+#include "SquadStore.h"
+#include "HunterStore.h"
 #include "HashTable.h"
+#include "IdMap.h"
+#include "HunterRecord.h"
+#include "SquadTransfer.h"
 
 
 
 class Huntech {
 private:
-    // Active squads by ID: squadId -> Squad*
-    AVLTree<int, Squad*> squadsById;
-
-    // Active squads by (auraSum, squadId), supports select(i)
-    AVLTree<AuraKey, Squad*, AuraKeyLess> squadsByAura;
-
-    // All hunters ever: hunterId -> Hunter*
-    HashTable<int, Hunter*> huntersById;
-
-    // Manual lists to free all allocated objects (no STL)
-    struct SquadNode {
-        Squad* s;
-        SquadNode* next;
-        SquadNode(Squad* ss, SquadNode* nn) : s(ss), next(nn) {}
-    };
-    struct HunterNode {
-        Hunter* h;
-        HunterNode* next;
-        HunterNode(Hunter* hh, HunterNode* nn) : h(hh), next(nn) {}
-    };
-
-    SquadNode* allSquads;
-    HunterNode* allHunters;
+    // Active squads by ID: squadId -> DSU root of the squad's set
+    IdMap<SquadIndex> squadsById;
+
+    // Active squads by (auraSum, squadId), supports select(i) and aura-sum
+    // folds over rank/key ranges
+    typedef AVLTree<AuraKey, SquadIndex, AuraKeyLess, AuraSumAugment> AuraTree;
+    AuraTree squadsByAura;
+
+    // Optional persistent copy of the same order for snapshot readers
+    // (enable_aura_snapshots): (auraSum, squadId) -> squadId. While on, it
+    // follows every change of squadsByAura; a copy that missed one (out of
+    // memory) is marked stale and rebuilt by the next take_aura_snapshot.
+    typedef PersistentAVLTree<AuraKey, int, AuraKeyLess> AuraIndex;
+    AuraIndex auraIndex;
+    bool auraIndexOn;
+    bool auraIndexStale;
+
+    // All hunters ever: hunterId -> index into hunterStore
+    IdMap<HunterIndex> huntersById;
+
+    // Reclamation mode (enable_reclamation): hunters of dead sets are freed
+    // and leave huntersById; their id stays taken here with the final fight
+    // count, which can no longer change.
+    HashTable<int, int> reclaimedFights;
+    bool reclaimOn;
+
+    // Owners of every squad/hunter ever created (freed in bulk)
+    SquadStore squadStore;
+    HunterStore hunterStore;
 
 private:
-    // DSU find with potentials (path compression)
-    Squad* findSquad(Squad* x);
+    // DSU find with potentials (iterative, two-pass path compression)
+    SquadIndex findSquad(SquadIndex x);
+
+    // fightPotential(block) = offset(block->root) + root's lazy fights
+    int fightPotential(SquadIndex x);
+
+    // nenShiftToRoot(block) = offset(block->root) + root's lazy prefix
+    NenVec nenShiftToRoot(SquadIndex x);
+
+    // DSU find without path compression: returns the root and the sums of
+    // the offsets from x up to and including the root (i.e. x's potentials),
+    // changes nothing (safe for concurrent readers). Union by size bounds the
+    // walk by log2(#squads) hops.
+    SquadIndex findSquadReadOnly(SquadIndex x, int& fightOffset, NenVec& nenOffset) const;
+
+    // DSU union by size: attaches the smaller set under the larger one,
+    // keeps all potentials, returns the new root
+    SquadIndex linkSets(SquadIndex a, SquadIndex b);
+
+    // appends h to the hunter list of the set rooted at root
+    void appendToSet(SquadIndex root, HunterIndex h);
+
+    // f(h) for every hunter of the set rooted at root, in join order
+    // (f may free h)
+    template <typename F>
+    void forEachHunterInSet(SquadIndex root, F f) {
+        HunterIndex last = squadStore.at(root).lastHunter;
+        if (last == NO_HUNTER) return;
+        HunterIndex h = hunterStore.next(last);
+        while (true) {
+            HunterIndex next = hunterStore.next(h);
+            bool end = (h == last);
+            f(h);
+            if (end) return;
+            h = next;
+        }
+    }
 
-    // fightPotential(block) = root.fightsAddRoot + offset(block->root)
-    int fightPotential(Squad* x);
+    // Frees the dead set rooted at r: its hunters move to reclaimedFights
+    // first, then every hunter and squad of the set goes back to the stores.
+    // false (set left untouched) if out of memory.
+    bool reclaimSet(SquadIndex r);
 
-    // nenShiftToRoot(block) = offset(block->root) in NenAbility space
-    NenAbility nenShiftToRoot(Squad* x);
+    // returns the objects of a set whose hunters all left huntersById
+    void freeSet(SquadIndex r);
+
+    static SquadDuelSide duelSideOf(const Squad& r);
+
+    // squadsByAura insert/remove, mirrored to auraIndex when it is on
+    void auraInsert(SquadIndex s);
+    void auraRemove(SquadIndex s);
+
+    // auraIndex := squadsByAura, O(n)
+    void auraIndexRebuild();
 
     void freeAll();
+
+    // freeAll() plus emptied (still usable) hash tables
+    void resetToEmpty();
     //
     // Here you may add anything you need to implement your Huntech class
     //
@@ -92,6 +151,119 @@ public:
     StatusType force_join(int forcingSquadId, int forcedSquadId);
 
     // } </DO-NOT-MODIFY>
+
+    // ---------- Extensions (not part of the wet API) ----------
+
+    // Binary snapshot of the full state (HuntechSnapshot.cpp).
+    // load_snapshot validates the whole file before replacing the current
+    // state; on FAILURE from a corrupt file the old state is kept.
+    StatusType save_snapshot(const char* path);
+    StatusType load_snapshot(const char* path);
+
+    // Equivalent to add_squad(squadIds[i]) for every i, then
+    // add_hunter(...) for every hunters[j], in array order (HuntechBulk.cpp).
+    // Returns how many of those calls succeed; calls that would fail leave
+    // no trace, exactly as when issued one by one. On an empty Huntech the
+    // whole load is done with sorts and linear passes.
+    output_t<int> bulk_load(const int* squadIds, int squadCount,
+                            const HunterRecord* hunters, int hunterCount);
+
+    // Position of an active squad in the collective-aura order, i.e. the i
+    // with get_ith_collective_aura_squad(i) == squadId. O(log n).
+    output_t<int> get_squad_aura_rank(int squadId);
+
+    // Number of active squads with minAura <= collective aura <= maxAura.
+    // O(log n).
+    output_t<int> count_squads_in_aura_range(long long minAura, long long maxAura);
+
+    // Squad ids at collective-aura ranks i..j (1-indexed, inclusive) written
+    // to out[0..j-i]; returns j - i + 1. O(log n + (j - i)).
+    output_t<int> get_aura_squads_range(int i, int j, int* out);
+
+    // Total collective aura of the k squads with the highest collective
+    // aura (ranks size-k+1..size). O(log n).
+    output_t<long long> get_top_squads_aura_sum(int k);
+
+    // Total collective aura of the active squads with
+    // minAura <= collective aura <= maxAura. O(log n).
+    output_t<long long> get_aura_band_sum(long long minAura, long long maxAura);
+
+    // Read-only twins of the four queries: same answers, but no DSU path
+    // compression and no other state change, so any number of threads may
+    // call them at once while no mutation runs (tools/ConcurrentHuntech.h).
+    output_t<int> peek_hunter_fights_number(int hunterId) const;
+    output_t<int> peek_squad_experience(int squadId) const;
+    output_t<int> peek_ith_collective_aura_squad(int i) const;
+    output_t<NenAbility> peek_partial_nen_ability(int hunterId) const;
+
+    // Compresses the DSU path of every squad ever created, O(#squads), so
+    // that later peek_* walks are one hop. Writer-side maintenance for the
+    // concurrent mode; answers are unchanged.
+    void compress_paths();
+
+    // ---- Hooks for the sharded front end (tools/ShardedHuntech.h) ----
+
+    // Collective aura of an active squad. O(1) after the id lookup.
+    output_t<long long> get_squad_collective_aura(int squadId);
+
+    // Number of active squads ordered before the key (aura, squadId) in the
+    // collective-aura order. O(log n).
+    output_t<int> count_squads_before(long long aura, int squadId);
+
+    // What squad_duel reads from an active squad (FAILURE if not active).
+    output_t<SquadDuelSide> get_duel_side(int squadId);
+
+    // squad_duel's rules for two sides that both have hunters: returns the
+    // squad_duel answer and sets the experience each side gains.
+    static int duel_outcome(const SquadDuelSide& a, const SquadDuelSide& b,
+                            int& gainA, int& gainB);
+
+    // force_join's strength rule for two active squads: whether `forcing`
+    // may absorb `forced`.
+    static bool force_join_allowed(const SquadDuelSide& forcing, const SquadDuelSide& forced);
+
+    // One side of a duel decided elsewhere: experience += experienceGain
+    // and every hunter of the squad fought once more.
+    StatusType apply_duel_result(int squadId, int experienceGain);
+
+    // Hands an active squad with every hunter of its set to `out` and drops
+    // it from this instance (its ids become free here). O(set size).
+    StatusType export_squad(int squadId, SquadTransfer& out);
+
+    // Recreates an exported squad as a fresh set: same id, experience and
+    // hunters with the same fights and partial Nen abilities. FAILURE (and
+    // no change) if the squad id is active or a hunter id exists here.
+    StatusType import_squad(const SquadTransfer& in);
+
+    // ---- Consistent snapshots of the collective-aura order ----
+
+    // Read-only view: size(), select(i) (key = (collective aura, squadId),
+    // the i-th squad of get_ith_collective_aura_squad at the time it was
+    // taken), rank(), countLess(), forEachInOrder(). It never changes, and
+    // other threads may read and release it while this instance keeps
+    // mutating. Release every snapshot before the Huntech is destroyed.
+    typedef AuraIndex::Snapshot AuraSnapshot;
+
+    // Starts keeping a persistent (path-copying) copy of the aura order:
+    // O(n) now, then O(log n) extra work per aura change.
+    StatusType enable_aura_snapshots();
+
+    // O(1) view of the current order. FAILURE if snapshots are not enabled.
+    StatusType take_aura_snapshot(AuraSnapshot& out);
+
+    // ---- Memory reclamation ----
+
+    // From now on remove_squad frees the dead set (all its squads and
+    // hunters) and export_squad the exported one, O(set size); later
+    // add_squad/add_hunter reuse the slots. A freed hunter's id stays taken
+    // and only its final fight count is kept, so every answer is unchanged
+    // (get_hunter_fights_number still reports it, the other queries FAILURE).
+    void enable_reclamation();
+
+    // Compaction pass: frees every dead set still allocated (those that died
+    // before reclamation was enabled or while memory ran out). O(#squads).
+    // Returns the number of squads and hunters freed.
+    output_t<int> reclaim_dead_sets();
 };
 
 #endif // HUNTECH26A2_H_
@@ -0,0 +1,176 @@
+// Bulk import: Huntech::bulk_load.
+//
+// On an empty Huntech every squad is a fresh DSU root (no lazy terms), so the
+// result of issuing the calls one at a time can be computed directly:
+//   1) squads: radix-sort the valid ids (stable), the first occurrence of an
+//      id wins, later duplicates are the calls that would return FAILURE
+//   2) hunters: radix-sort the valid rows by squadId and merge them with the
+//      sorted squad ids to resolve each row's squad (missing squad = FAILURE)
+//   3) radix-sort the resolved rows by hunterId, first occurrence wins
+//   4) one pass in array order creates the hunters and accumulates auraSum,
+//      nenSum, huntersCount and each hunter's join-order partial Nen ability
+//   5) the aura tree is built bottom-up from the sorted array
+// Sorting is O(n) per key byte, everything else is linear. The hash tables
+// and the squad/hunter stores are sized once for the final counts.
+
+#include "Huntech26a2.h"
+#include "RadixSort.h"
+#include "ScratchArray.h"
+
+output_t<int> Huntech::bulk_load(const int* squadIds, int squadCount,
+                                 const HunterRecord* hunters, int hunterCount)
+{
+    if (squadCount < 0 || hunterCount < 0 ||
+        (squadCount > 0 && !squadIds) || (hunterCount > 0 && !hunters)) {
+        return StatusType::INVALID_INPUT;
+    }
+
+    // Not empty: existing roots may carry lazy terms (and reclaimed hunter
+    // ids are taken), replay call by call
+    if (squadStore.size() != 0 || hunterStore.size() != 0 || !reclaimedFights.isEmpty()) {
+        int done = 0;
+        for (int i = 0; i < squadCount; i++) {
+            StatusType st = add_squad(squadIds[i]);
+            if (st == StatusType::ALLOCATION_ERROR) return st;
+            if (st == StatusType::SUCCESS) done++;
+        }
+        for (int j = 0; j < hunterCount; j++) {
+            const HunterRecord& r = hunters[j];
+            StatusType st = add_hunter(r.hunterId, r.squadId, r.nenType, r.aura, r.fightsHad);
+            if (st == StatusType::ALLOCATION_ERROR) return st;
+            if (st == StatusType::SUCCESS) done++;
+        }
+        return done;
+    }
+
+    try {
+        const int ns = squadCount;
+        const int nh = hunterCount;
+        const int n = (ns > nh) ? ns : nh;
+
+        ScratchArray<unsigned long long> key(n);
+        ScratchArray<int> order(n);
+        ScratchArray<int> tmp(n);
+
+        // ---- 1) squads ----
+        int cand = 0;
+        for (int i = 0; i < ns; i++) {
+            key[i] = (unsigned long long)(unsigned int)squadIds[i];
+            if (squadIds[i] > 0) order[cand++] = i;
+        }
+        radixSortIndices(key.data(), order.data(), tmp.data(), cand);
+
+        ScratchArray<SquadIndex> squadAt(ns);
+        for (int i = 0; i < ns; i++) squadAt[i] = NO_SQUAD;
+
+        // keep the first occurrence of every id; order[0..na) stays sorted by id
+        int na = 0;
+        for (int k = 0; k < cand; k++) {
+            int i = order[k];
+            if (na > 0 && squadIds[order[na - 1]] == squadIds[i]) continue;
+            order[na++] = i;
+        }
+
+        // creation in call order, as add_squad would do it
+        ScratchArray<unsigned char> accepted(ns);
+        for (int i = 0; i < ns; i++) accepted[i] = 0;
+        for (int k = 0; k < na; k++) accepted[order[k]] = 1;
+        squadStore.reserve(na);
+        for (int i = 0; i < ns; i++) {
+            if (accepted[i]) squadAt[i] = squadStore.create(squadIds[i]);
+        }
+
+        ScratchArray<int> ids(na);
+        ScratchArray<SquadIndex> byId(na);
+        for (int k = 0; k < na; k++) {
+            ids[k] = squadIds[order[k]];
+            byId[k] = squadAt[order[k]];
+        }
+
+        // ---- 2) resolve each hunter row's squad ----
+        ScratchArray<SquadIndex> target(nh);
+        cand = 0;
+        for (int j = 0; j < nh; j++) {
+            const HunterRecord& r = hunters[j];
+            target[j] = NO_SQUAD;
+            key[j] = (unsigned long long)(unsigned int)r.squadId;
+            if (r.hunterId > 0 && r.squadId > 0 && r.nenType.isValid() &&
+                r.aura >= 0 && r.fightsHad >= 0) {
+                order[cand++] = j;
+            }
+        }
+        radixSortIndices(key.data(), order.data(), tmp.data(), cand);
+
+        for (int k = 0, s = 0; k < cand; k++) {
+            int j = order[k];
+            while (s < na && ids[s] < hunters[j].squadId) s++;
+            if (s < na && ids[s] == hunters[j].squadId) target[j] = byId[s];
+        }
+
+        // ---- 3) first occurrence (in call order) of every hunter id wins ----
+        int resolved = 0;
+        for (int j = 0; j < nh; j++) {
+            if (target[j] == NO_SQUAD) continue;
+            key[j] = (unsigned long long)(unsigned int)hunters[j].hunterId;
+            order[resolved++] = j;
+        }
+        radixSortIndices(key.data(), order.data(), tmp.data(), resolved);
+        for (int k = 1; k < resolved; k++) {
+            if (hunters[order[k]].hunterId == hunters[order[k - 1]].hunterId) {
+                target[order[k]] = NO_SQUAD;
+            }
+        }
+
+        int hunterTotal = 0;
+        for (int j = 0; j < nh; j++) {
+            if (target[j] != NO_SQUAD) hunterTotal++;
+        }
+
+        // ---- 4) hunters in call order + squad aggregates ----
+        huntersById.reserve(hunterTotal);
+        hunterStore.reserve(hunterTotal);
+        for (int j = 0; j < nh; j++) {
+            SquadIndex r = target[j];
+            if (r == NO_SQUAD) continue;
+            const HunterRecord& row = hunters[j];
+            Squad& squad = squadStore.at(r);
+
+            // fresh root: no lazy fights or prefix
+            NenVec nen = NenVec::fromAbility(row.nenType);
+            HunterIndex h = hunterStore.create(row.hunterId, row.aura, row.fightsHad,
+                                               squad.nenSum.unpack() + nen, r);
+            (void)huntersById.insert(row.hunterId, h);
+            appendToSet(r, h);
+
+            squad.huntersCount += 1;
+            squad.auraSum += (long long)row.aura;
+            squad.nenSum += nen;
+        }
+
+        // ---- 5) indexes ----
+        squadsById.reserve(na);
+        for (int k = 0; k < na; k++) (void)squadsById.insert(ids[k], byId[k]);
+
+        // byId is in id order; a stable sort by auraSum gives (aura, id) order
+        for (int k = 0; k < na; k++) {
+            key[k] = (unsigned long long)squadStore.at(byId[k]).auraSum;
+            order[k] = k;
+        }
+        radixSortIndices(key.data(), order.data(), tmp.data(), na);
+
+        ScratchArray<AuraKey> auraKeys(na);
+        ScratchArray<SquadIndex> byAura(na);
+        for (int k = 0; k < na; k++) {
+            SquadIndex s = byId[order[k]];
+            auraKeys[k] = AuraKey(squadStore.at(s).auraSum, squadStore.at(s).id);
+            byAura[k] = s;
+        }
+        squadsByAura.buildFromSorted(auraKeys.data(), byAura.data(), na);
+        auraIndexRebuild();
+
+        return na + hunterTotal;
+    } catch (const std::bad_alloc&) {
+        resetToEmpty();
+        return StatusType::ALLOCATION_ERROR;
+    }
+}
@@ -0,0 +1,466 @@
+// Binary snapshot save/restore of the full Huntech state.
+//
+// File layout (native little-endian, fixed-width records):
+//   SnapHeader
+//   SnapSquad  x squads    every allocated squad, in SquadStore index order
+//                          (save numbers them into Squad::index = record
+//                          number)
+//   SnapHunter x hunters   every stored hunter, set by set in join order
+//                          (hunters handed to another instance by
+//                          export_squad are left out)
+//   SnapActive x active    active squads in id order (id -> squad record)
+//   SnapAura   x active    squadsByAura in key order ((aura, id) -> squad record)
+//   SnapReclaimed x reclaimed  ids of freed hunters with their final fights
+//                          (version 2; version 1 files have none)
+//
+// The DSU forest is stored as parent record numbers together with all
+// potentials (fight/Nen offsets, fightsAddRoot, nenAddRoot) and each hunter's
+// baseFights/localPrefixAtJoin, so a restore reproduces the exact state
+// without replaying any command. In memory a DsuNode keeps a root's lazy
+// terms in its offset fields (Squad.h); the file keeps the two apart.
+// HunterStore keeps only the sum localPrefixAtJoin + ability; save splits
+// it again with the previous hunter of the set (see HunterStore.h). The aura
+// tree is rebuilt bottom-up from its sorted section in O(n) and the hash
+// tables and stores are pre-sized once. The
+// per-set hunter lists and squad cycles are not stored; a restore rebuilds
+// them (each list in record order).
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "Huntech26a2.h"
+#include "RadixSort.h"
+#include "ScratchArray.h"
+
+namespace {
+
+const char SNAP_MAGIC[8] = { 'H', 'T', 'S', 'N', 'A', 'P', '0', '1' };
+const uint32_t SNAP_VERSION = 2;
+
+struct SnapHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reclaimed;          // 0 in version 1 (was reserved)
+    uint64_t squads;
+    uint64_t hunters;
+    uint64_t active;
+};
+
+struct SnapSquad {
+    int32_t id;
+    int32_t parent;              // record number, -1 for a DSU root
+    int32_t experience;
+    int32_t huntersCount;
+    int64_t auraSum;
+    int32_t fightOffsetToParent;
+    int32_t fightsAddRoot;
+    int32_t setSize;
+    uint8_t alive;
+    uint8_t pad[3];
+    int32_t nenSum[6];
+    int32_t nenOffsetToParent[6];
+    int32_t nenAddRoot[6];
+};
+
+struct SnapHunter {
+    int32_t id;
+    int32_t aura;
+    int32_t baseFights;
+    int32_t block;               // squad record number
+    int32_t ability[6];
+    int32_t localPrefixAtJoin[6];
+};
+
+struct SnapActive {
+    int32_t id;
+    int32_t squad;
+};
+
+struct SnapAura {
+    int64_t aura;
+    int32_t id;
+    int32_t squad;
+};
+
+struct SnapReclaimed {
+    int32_t id;
+    int32_t fights;
+};
+
+const size_t IO_BUFFER = (size_t)1 << 20;
+
+void nenOut(const NenVec& a, int32_t out[6]) {
+    for (int i = 0; i < 6; i++) out[i] = a.c[i];
+}
+
+NenVec nenIn(const int32_t in[6]) {
+    NenVec v = NenVec::zero();
+    for (int i = 0; i < 6; i++) v.c[i] = in[i];
+    return v;
+}
+
+// Closes the snapshot file on every exit path.
+struct FileGuard {
+    FILE* f;
+    explicit FileGuard(FILE* file) : f(file) {}
+    ~FileGuard() { close(); }
+    bool close() {
+        bool ok = !f || fclose(f) == 0;
+        f = nullptr;
+        return ok;
+    }
+    FileGuard(const FileGuard&) = delete;
+    FileGuard& operator=(const FileGuard&) = delete;
+};
+
+template <typename T>
+bool readAll(FILE* f, T* dst, uint64_t n) {
+    return n == 0 || fread(dst, sizeof(T), (size_t)n, f) == (size_t)n;
+}
+
+} // namespace
+
+StatusType Huntech::save_snapshot(const char* path) {
+    if (!path) return StatusType::INVALID_INPUT;
+
+    try {
+        // record numbers: freed slots leave holes in the index order
+        int ns = 0;
+        squadStore.forEach([&](SquadIndex s) { squadStore.at(s).index = ns++; });
+
+        // squadsById is unordered: the id section is sorted from the aura
+        // tree, which holds exactly the same active squads
+        const int na = squadsByAura.size();
+        ScratchArray<unsigned long long> idKey(na);
+        ScratchArray<SnapActive> byAuraPos(na);
+        ScratchArray<int> order(na);
+        ScratchArray<int> tmp(na);
+        int k = 0;
+        squadsByAura.forEachInOrder([&](const AuraKey& key, const SquadIndex& s) {
+            byAuraPos[k].id = key.squadId;
+            byAuraPos[k].squad = squadStore.at(s).index;
+            idKey[k] = (unsigned long long)(unsigned int)key.squadId;
+            order[k] = k;
+            k++;
+        });
+        radixSortIndices(idKey.data(), order.data(), tmp.data(), na);
+
+        FILE* f = fopen(path, "wb");
+        if (!f) return StatusType::FAILURE;
+        setvbuf(f, nullptr, _IOFBF, IO_BUFFER);
+        FileGuard file(f);
+
+        SnapHeader h;
+        memcpy(h.magic, SNAP_MAGIC, sizeof(SNAP_MAGIC));
+        h.version = SNAP_VERSION;
+        h.reclaimed = (uint32_t)reclaimedFights.size();
+        h.squads = (uint64_t)ns;
+        h.hunters = (uint64_t)huntersById.size();
+        h.active = (uint64_t)na;
+
+        bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+
+        squadStore.forEach([&](SquadIndex si) {
+            const Squad& s = squadStore.at(si);
+            const DsuNode& n = squadStore.node(si);
+            const bool root = (n.parent == NO_SQUAD);
+            SnapSquad r;
+            memset(&r, 0, sizeof(r));
+            r.id = s.id;
+            r.parent = root ? -1 : squadStore.at(n.parent).index;
+            r.experience = s.experience;
+            r.huntersCount = s.huntersCount;
+            r.auraSum = s.auraSum;
+            r.setSize = s.setSize;
+            r.alive = s.alive ? 1 : 0;
+            nenOut(s.nenSum.unpack(), r.nenSum);
+            if (root) {
+                r.fightsAddRoot = n.fightOffset;
+                nenOut(n.nenOffset.unpack(), r.nenAddRoot);
+            } else {
+                r.fightOffsetToParent = n.fightOffset;
+                nenOut(n.nenOffset.unpack(), r.nenOffsetToParent);
+            }
+            ok = ok && fwrite(&r, sizeof(r), 1, f) == 1;
+        });
+
+        // hunters set by set in join order; the DSU is read without
+        // compression, the squad section already holds the current links
+        // (export_squad detaches a whole set, so a set is written either
+        // completely or not at all and every written hunter's split is taken
+        // against the hunter written just before it)
+        squadStore.forEach([&](SquadIndex root) {
+            if (squadStore.node(root).parent != NO_SQUAD) return;
+            HunterIndex last = squadStore.at(root).lastHunter;
+            if (last == NO_HUNTER || hunterStore.block(last) == NO_SQUAD) return;
+            NenVec prev = NenVec::zero();   // partial ability of the previous hunter
+            forEachHunterInSet(root, [&](HunterIndex hu) {
+                SquadIndex block = hunterStore.block(hu);
+                int fightOffset;
+                NenVec shift;
+                (void)findSquadReadOnly(block, fightOffset, shift);
+                NenVec partial = hunterStore.partial(hu);
+                NenVec ability = partial + shift - prev;
+                prev = partial + shift;
+
+                SnapHunter r;
+                r.id = hunterStore.id(hu);
+                r.aura = hunterStore.aura(hu);
+                r.baseFights = hunterStore.baseFights(hu);
+                r.block = squadStore.at(block).index;
+                nenOut(ability, r.ability);
+                nenOut(partial - ability, r.localPrefixAtJoin);
+                ok = ok && fwrite(&r, sizeof(r), 1, f) == 1;
+            });
+        });
+
+        for (int i = 0; i < na; i++) {
+            ok = ok && fwrite(&byAuraPos[order[i]], sizeof(SnapActive), 1, f) == 1;
+        }
+
+        squadsByAura.forEachInOrder([&](const AuraKey& key, const SquadIndex& s) {
+            SnapAura r;
+            r.aura = key.aura;
+            r.id = key.squadId;
+            r.squad = squadStore.at(s).index;
+            ok = ok && fwrite(&r, sizeof(r), 1, f) == 1;
+        });
+
+        reclaimedFights.forEach([&](const int& id, const int& fights) {
+            SnapReclaimed r;
+            r.id = id;
+            r.fights = fights;
+            ok = ok && fwrite(&r, sizeof(r), 1, f) == 1;
+        });
+
+        ok = file.close() && ok;
+        return ok ? StatusType::SUCCESS : StatusType::FAILURE;
+    } catch (const std::bad_alloc&) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+}
+
+StatusType Huntech::load_snapshot(const char* path) {
+    if (!path) return StatusType::INVALID_INPUT;
+
+    FILE* f = fopen(path, "rb");
+    if (!f) return StatusType::FAILURE;
+    setvbuf(f, nullptr, _IOFBF, IO_BUFFER);
+    FileGuard file(f);
+
+    bool rebuilding = false;
+    try {
+        // ---- 1) read + validate everything before touching the live state ----
+        SnapHeader h;
+        if (fread(&h, sizeof(h), 1, f) != 1 ||
+            memcmp(h.magic, SNAP_MAGIC, sizeof(SNAP_MAGIC)) != 0 ||
+            h.version < 1 || h.version > SNAP_VERSION ||
+            (h.version == 1 && h.reclaimed != 0) || h.reclaimed > 0x7fffffffU ||
+            h.squads > 0x7fffffffULL || h.hunters > 0x7fffffffULL || h.active > h.squads) {
+            return StatusType::FAILURE;
+        }
+
+        const int ns = (int)h.squads;
+        const int nh = (int)h.hunters;
+        const int na = (int)h.active;
+        const int nr = (int)h.reclaimed;
+
+        ScratchArray<SnapSquad> squads((long long)h.squads);
+        ScratchArray<SnapHunter> hunters((long long)h.hunters);
+        ScratchArray<SnapActive> active((long long)h.active);
+        ScratchArray<SnapAura> aura((long long)h.active);
+        ScratchArray<SnapReclaimed> reclaimed((long long)h.reclaimed);
+
+        bool ok = readAll(f, squads.data(), h.squads) &&
+                  readAll(f, hunters.data(), h.hunters) &&
+                  readAll(f, active.data(), h.active) &&
+                  readAll(f, aura.data(), h.active) &&
+                  readAll(f, reclaimed.data(), h.reclaimed) &&
+                  fgetc(f) == EOF;
+        file.close();
+        if (!ok) return StatusType::FAILURE;
+
+        // DSU links in range and acyclic (state: 0 new, 1 on current path, 2 done)
+        ScratchArray<unsigned char> state((long long)h.squads);
+        for (int i = 0; i < ns; i++) {
+            int p = squads[i].parent;
+            if (p < -1 || p >= ns || p == i || squads[i].alive > 1) return StatusType::FAILURE;
+            state[i] = 0;
+        }
+        for (int i = 0; i < ns; i++) {
+            int x = i;
+            while (x >= 0 && state[x] == 0) {
+                state[x] = 1;
+                x = squads[x].parent;
+            }
+            if (x >= 0 && state[x] == 1) return StatusType::FAILURE; // cycle
+            for (x = i; x >= 0 && state[x] == 1; x = squads[x].parent) state[x] = 2;
+        }
+
+        // hunter ids (live and reclaimed) positive and unique, blocks in range
+        {
+            HashTable<int, int> seen;
+            seen.reserve((long long)nh + nr);
+            for (int i = 0; i < nh; i++) {
+                const SnapHunter& r = hunters[i];
+                if (r.id <= 0 || r.block < 0 || r.block >= ns || !seen.insert(r.id, i)) {
+                    return StatusType::FAILURE;
+                }
+            }
+            for (int i = 0; i < nr; i++) {
+                if (reclaimed[i].id <= 0 || !seen.insert(reclaimed[i].id, nh + i)) {
+                    return StatusType::FAILURE;
+                }
+            }
+        }
+
+        // every record's DSU root (the links are checked above), then each
+        // root's setSize and huntersCount against the squad and hunter
+        // records actually found in its set
+        ScratchArray<int> rootOf((long long)h.squads);
+        {
+            for (int i = 0; i < ns; i++) rootOf[i] = -1;
+            for (int i = 0; i < ns; i++) {
+                int x = i;
+                while (rootOf[x] < 0 && squads[x].parent >= 0) x = squads[x].parent;
+                int r = (rootOf[x] >= 0) ? rootOf[x] : x;
+                for (int y = i; rootOf[y] < 0; y = squads[y].parent) {
+                    rootOf[y] = r;
+                    if (squads[y].parent < 0) break;
+                }
+            }
+
+            ScratchArray<int> members((long long)h.squads);
+            ScratchArray<int> held((long long)h.squads);
+            for (int i = 0; i < ns; i++) members[i] = held[i] = 0;
+            for (int i = 0; i < ns; i++) members[rootOf[i]] += 1;
+            for (int i = 0; i < nh; i++) held[rootOf[hunters[i].block]] += 1;
+            for (int i = 0; i < ns; i++) {
+                if (squads[i].parent == -1 &&
+                    (squads[i].setSize != members[i] || squads[i].huntersCount != held[i])) {
+                    return StatusType::FAILURE;
+                }
+            }
+        }
+
+        // active squads are live DSU roots carrying their own id and aura key,
+        // both sections strictly increasing
+        AuraKeyLess auraLess;
+        for (int i = 0; i < na; i++) {
+            if (i > 0 && (active[i - 1].id >= active[i].id ||
+                          !auraLess(AuraKey(aura[i - 1].aura, aura[i - 1].id),
+                                    AuraKey(aura[i].aura, aura[i].id)))) {
+                return StatusType::FAILURE;
+            }
+            int sa = active[i].squad;
+            int sb = aura[i].squad;
+            if (sa < 0 || sa >= ns || sb < 0 || sb >= ns) return StatusType::FAILURE;
+            const SnapSquad& a = squads[sa];
+            const SnapSquad& b = squads[sb];
+            if (a.parent != -1 || !a.alive || a.id != active[i].id) return StatusType::FAILURE;
+            if (b.parent != -1 || !b.alive || b.id != aura[i].id || b.auraSum != aura[i].aura) {
+                return StatusType::FAILURE;
+            }
+        }
+
+        // both sections name the same squads, which are exactly the live DSU
+        // roots: active ids are strictly increasing and each names its
+        // record's id, so active lists na distinct records; every aura entry
+        // must hit one of them, once
+        {
+            int liveRoots = 0;
+            for (int i = 0; i < ns; i++) {
+                state[i] = 0;
+                if (squads[i].parent == -1 && squads[i].alive) liveRoots++;
+            }
+            if (liveRoots != na) return StatusType::FAILURE;
+            for (int i = 0; i < na; i++) state[active[i].squad] = 1;
+            for (int i = 0; i < na; i++) {
+                if (state[aura[i].squad] != 1) return StatusType::FAILURE;
+                state[aura[i].squad] = 2;
+            }
+        }
+
+        // ---- 2) rebuild ----
+        rebuilding = true;
+        resetToEmpty();
+
+        squadStore.reserve(ns);
+        ScratchArray<SquadIndex> byIndex((long long)h.squads);
+        for (int i = 0; i < ns; i++) {
+            const SnapSquad& r = squads[i];
+            SquadIndex si = squadStore.create(r.id);
+            Squad& s = squadStore.at(si);
+            s.alive = (r.alive != 0);
+            s.experience = r.experience;
+            s.huntersCount = r.huntersCount;
+            s.auraSum = r.auraSum;
+            s.nenSum = NenPacked::of(nenIn(r.nenSum));
+            s.setSize = r.setSize;
+            byIndex[i] = si;
+        }
+        for (int i = 0; i < ns; i++) {
+            // a root's offset fields hold its lazy terms
+            const SnapSquad& r = squads[i];
+            DsuNode& n = squadStore.node(byIndex[i]);
+            if (r.parent >= 0) {
+                n.parent = byIndex[r.parent];
+                n.fightOffset = r.fightOffsetToParent;
+                n.nenOffset = NenPacked::of(nenIn(r.nenOffsetToParent));
+            } else {
+                n.fightOffset = r.fightsAddRoot;
+                n.nenOffset = NenPacked::of(nenIn(r.nenAddRoot));
+            }
+        }
+        for (int i = 0; i < ns; i++) {
+            // join each non-root's singleton cycle to its root's cycle
+            SquadIndex s = byIndex[i];
+            SquadIndex root = byIndex[rootOf[i]];
+            if (root == s) continue;
+            SquadIndex t = squadStore.at(s).nextInSet;
+            squadStore.at(s).nextInSet = squadStore.at(root).nextInSet;
+            squadStore.at(root).nextInSet = t;
+        }
+
+        huntersById.reserve(nh);
+        hunterStore.reserve(nh);
+        for (int i = 0; i < nh; i++) {
+            const SnapHunter& r = hunters[i];
+            HunterIndex hu = hunterStore.create(r.id, r.aura, r.baseFights,
+                                                nenIn(r.localPrefixAtJoin) + nenIn(r.ability),
+                                                byIndex[r.block]);
+            (void)huntersById.insert(r.id, hu);
+
+            // set lists in record order; the DSU stays as saved
+            appendToSet(byIndex[rootOf[r.block]], hu);
+        }
+
+        reclaimedFights.reserve(nr);
+        for (int i = 0; i < nr; i++) {
+            (void)reclaimedFights.insert(reclaimed[i].id, reclaimed[i].fights);
+        }
+
+        squadsById.reserve(na);
+        for (int i = 0; i < na; i++) {
+            (void)squadsById.insert(active[i].id, byIndex[active[i].squad]);
+        }
+
+        ScratchArray<AuraKey> keys((long long)h.active);
+        ScratchArray<SquadIndex> byAura((long long)h.active);
+        for (int i = 0; i < na; i++) {
+            keys[i] = AuraKey(aura[i].aura, aura[i].id);
+            byAura[i] = byIndex[aura[i].squad];
+        }
+        squadsByAura.buildFromSorted(keys.data(), byAura.data(), na);
+        auraIndexRebuild();
+
+        return StatusType::SUCCESS;
+    } catch (const std::bad_alloc&) {
+        if (rebuilding) {
+            // out of memory mid-rebuild: leave an empty Huntech
+            resetToEmpty();
+        }
+        return StatusType::ALLOCATION_ERROR;
+    }
+}
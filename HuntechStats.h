@@ -0,0 +1,162 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_HUNTECHSTATS_H
+#define DS_WET2_WINTER_2026_01_HUNTECHSTATS_H
+
+// Optional hot-path instrumentation, compiled in only with -DHUNTECH_STATS.
+//
+// Without the flag every HT_STAT_* macro expands to nothing, so the data
+// structures compile to exactly the uninstrumented code.
+// With the flag a single global HuntechStats record counts:
+// - AVLTree : rotations, searches and the nodes visited by them
+// - HashTable: lookups and probe lengths, growths, migrated slots, time spent rehashing
+// - IdMap   : direct-mode lookups, switches between direct and hashed mode
+// - DSU     : finds, hops to the root, nodes re-linked by path compression
+// - API     : calls and a power-of-two latency histogram per public method
+// huntechStatsDump() prints a snapshot (the replay driver calls it at the
+// end of a run and on SIGUSR1).
+
+#ifdef HUNTECH_STATS
+
+#include <chrono>
+#include <cstdio>
+
+enum HuntechApi {
+    API_ADD_SQUAD = 0,
+    API_REMOVE_SQUAD,
+    API_ADD_HUNTER,
+    API_SQUAD_DUEL,
+    API_GET_HUNTER_FIGHTS,
+    API_GET_SQUAD_EXPERIENCE,
+    API_GET_ITH_AURA_SQUAD,
+    API_GET_PARTIAL_NEN,
+    API_FORCE_JOIN,
+    API_COUNT
+};
+
+struct HuntechStats {
+    static const int LAT_BUCKETS = 40;   // bucket b: latency < 2^b ns
+
+    // AVLTree
+    unsigned long long avlRotations;
+    unsigned long long avlSearches;
+    unsigned long long avlSearchDepth;   // total nodes visited
+
+    // HashTable
+    unsigned long long htLookups;
+    unsigned long long htProbes;         // total slots inspected
+    unsigned long long htGrowths;
+    unsigned long long htMigratedSlots;
+    unsigned long long htRehashNanos;
+
+    // IdMap
+    unsigned long long idDirectLookups;
+    unsigned long long idToHashed;
+    unsigned long long idToDirect;
+
+    // DSU
+    unsigned long long dsuFinds;
+    unsigned long long dsuHops;          // total parent links followed
+    unsigned long long dsuCompressed;    // nodes re-hung under their root
+
+    // API
+    unsigned long long apiCalls[API_COUNT];
+    unsigned long long apiNanos[API_COUNT];
+    unsigned long long apiLatency[API_COUNT][LAT_BUCKETS];
+};
+
+inline HuntechStats& huntechStats() {
+    static HuntechStats s = HuntechStats();
+    return s;
+}
+
+inline void huntechStatsReset() {
+    huntechStats() = HuntechStats();
+}
+
+inline unsigned long long huntechStatsNow() {
+    return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Times one public Huntech call.
+class HuntechApiTimer {
+private:
+    int api;
+    unsigned long long start;
+
+public:
+    explicit HuntechApiTimer(int which) : api(which), start(huntechStatsNow()) {}
+    ~HuntechApiTimer() {
+        unsigned long long ns = huntechStatsNow() - start;
+        HuntechStats& s = huntechStats();
+        int b = 0;
+        while (b < HuntechStats::LAT_BUCKETS - 1 && (ns >> b) != 0) b++;
+        s.apiCalls[api] += 1;
+        s.apiNanos[api] += ns;
+        s.apiLatency[api][b] += 1;
+    }
+};
+
+// Adds the lifetime of a scope (in ns) to one counter.
+class HuntechScopeTimer {
+private:
+    unsigned long long& field;
+    unsigned long long start;
+
+public:
+    explicit HuntechScopeTimer(unsigned long long& f) : field(f), start(huntechStatsNow()) {}
+    ~HuntechScopeTimer() { field += huntechStatsNow() - start; }
+};
+
+inline void huntechStatsDump(FILE* out) {
+    static const char* names[API_COUNT] = {
+        "add_squad", "remove_squad", "add_hunter", "squad_duel",
+        "get_hunter_fights_number", "get_squad_experience",
+        "get_ith_collective_aura_squad", "get_partial_nen_ability", "force_join"
+    };
+    const HuntechStats& s = huntechStats();
+
+    fprintf(out, "== Huntech stats ==\n");
+    fprintf(out, "avl.rotations          %llu\n", s.avlRotations);
+    fprintf(out, "avl.searches           %llu\n", s.avlSearches);
+    fprintf(out, "avl.avg_depth          %.2f\n", s.avlSearches ? (double)s.avlSearchDepth / (double)s.avlSearches : 0.0);
+    fprintf(out, "hash.lookups           %llu\n", s.htLookups);
+    fprintf(out, "hash.avg_probe         %.2f\n", s.htLookups ? (double)s.htProbes / (double)s.htLookups : 0.0);
+    fprintf(out, "hash.growths           %llu\n", s.htGrowths);
+    fprintf(out, "hash.migrated_slots    %llu\n", s.htMigratedSlots);
+    fprintf(out, "hash.rehash_ms         %.3f\n", (double)s.htRehashNanos / 1e6);
+    fprintf(out, "id.direct_lookups      %llu\n", s.idDirectLookups);
+    fprintf(out, "id.to_hashed           %llu\n", s.idToHashed);
+    fprintf(out, "id.to_direct           %llu\n", s.idToDirect);
+    fprintf(out, "dsu.finds              %llu\n", s.dsuFinds);
+    fprintf(out, "dsu.avg_hops           %.2f\n", s.dsuFinds ? (double)s.dsuHops / (double)s.dsuFinds : 0.0);
+    fprintf(out, "dsu.compressed         %llu\n", s.dsuCompressed);
+
+    for (int a = 0; a < API_COUNT; a++) {
+        if (s.apiCalls[a] == 0) continue;
+        fprintf(out, "api.%-30s calls %llu  avg_ns %.1f  hist",
+                names[a], s.apiCalls[a], (double)s.apiNanos[a] / (double)s.apiCalls[a]);
+        for (int b = 0; b < HuntechStats::LAT_BUCKETS; b++) {
+            if (s.apiLatency[a][b]) fprintf(out, " <2^%d:%llu", b, s.apiLatency[a][b]);
+        }
+        fprintf(out, "\n");
+    }
+    fflush(out);
+}
+
+#define HT_STAT_ADD(field, n)   (huntechStats().field += (unsigned long long)(n))
+#define HT_STAT_API(api)        HuntechApiTimer huntechApiTimer_(api)
+#define HT_STAT_TIME(field)     HuntechScopeTimer huntechScopeTimer_(huntechStats().field)
+
+#else // !HUNTECH_STATS
+
+#define HT_STAT_ADD(field, n)   ((void)0)
+#define HT_STAT_API(api)        ((void)0)
+#define HT_STAT_TIME(field)     ((void)0)
+
+#endif // HUNTECH_STATS
+
+#endif // DS_WET2_WINTER_2026_01_HUNTECHSTATS_H
@@ -0,0 +1,20 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_HUNTERRECORD_H
+#define DS_WET2_WINTER_2026_01_HUNTERRECORD_H
+
+#include "wet2util.h"
+
+// One add_hunter call, as an input row of Huntech::bulk_load.
+
+struct HunterRecord {
+    int hunterId;
+    int squadId;
+    NenAbility nenType;
+    int aura;
+    int fightsHad;
+};
+
+#endif // DS_WET2_WINTER_2026_01_HUNTERRECORD_H
@@ -0,0 +1,150 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_HUNTERSTORE_H
+#define DS_WET2_WINTER_2026_01_HUNTERSTORE_H
+
+#include <new> // std::bad_alloc
+
+#include "DenseIndex.h"
+#include "NenVec.h"
+
+// All hunters, stored column by column: pages of PAGE_SIZE hunters, and
+// inside a page one array per field, all indexed by the same HunterIndex.
+// A query reads the page pointer and then only the columns it needs
+// (get_hunter_fights_number: baseFights + block).
+//
+// A hunter is stored permanently (even if its squad is removed), unless
+// reclamation is on (Huntech::enable_reclamation). It never moves between
+// squads; instead, squads are DSU-linked.
+//
+// Fights:
+//   totalFights = baseFights + fightPotential(block)
+//
+// Partial Nen Ability:
+//   partial + nenShiftToRoot(block)
+// where partial is the squad's Nen prefix at join time plus the hunter's own
+// ability. The ability itself is not kept: along the set's hunter list (join
+// order) it is the difference of two consecutive partial abilities, which is
+// how export_squad and save_snapshot recover it.
+//
+// 44 bytes per hunter. Pages are never moved (only the page table is
+// resized), so growth copies nothing and leaves at most one partly used
+// page; destroy() puts an index on a free list threaded through the next
+// column, and create() reuses it. No STL containers.
+
+class HunterStore {
+private:
+    static const int PAGE_SHIFT = 10;
+    static const HunterIndex PAGE_SIZE = 1u << PAGE_SHIFT;
+    static const HunterIndex PAGE_MASK = PAGE_SIZE - 1;
+    static const HunterIndex MAX_PAGES = NO_HUNTER >> PAGE_SHIFT;
+
+    struct Page {
+        int id[PAGE_SIZE];
+        int aura[PAGE_SIZE];
+        int baseFights[PAGE_SIZE];
+        SquadIndex block[PAGE_SIZE];     // DSU node the hunter joined; NO_SQUAD once detached
+        HunterIndex next[PAGE_SIZE];     // next hunter of the same set (circular), or next free index
+        NenPacked partial[PAGE_SIZE];
+    };
+
+    Page** pages;            // page table
+    HunterIndex pageCount;
+    HunterIndex pageCap;
+
+    HunterIndex used;        // indices handed out so far
+    HunterIndex freeHead;
+    int live;
+
+private:
+    Page& page(HunterIndex h) const { return *pages[h >> PAGE_SHIFT]; }
+
+    void addPage() {
+        if (pageCount == MAX_PAGES) throw std::bad_alloc();
+        if (pageCount == pageCap) {
+            HunterIndex newCap = pageCap ? pageCap * 2 : 8;
+            Page** bigger = new Page*[newCap];
+            for (HunterIndex i = 0; i < pageCount; i++) bigger[i] = pages[i];
+            delete[] pages;
+            pages = bigger;
+            pageCap = newCap;
+        }
+        pages[pageCount] = new Page;
+        pageCount += 1;
+    }
+
+public:
+    HunterStore()
+        : pages(nullptr), pageCount(0), pageCap(0), used(0), freeHead(NO_HUNTER), live(0) {}
+    ~HunterStore() { releaseAll(); }
+
+    HunterStore(const HunterStore&) = delete;
+    HunterStore& operator=(const HunterStore&) = delete;
+
+    int size() const { return live; }
+
+    // room for n live hunters without further allocation (the free list
+    // holds exactly the used - live slots below used)
+    void reserve(long long n) {
+        while ((long long)pageCount * PAGE_SIZE < n) addPage();
+    }
+
+    HunterIndex create(int id, int aura, int baseFights, const NenVec& partial, SquadIndex block) {
+        HunterIndex h;
+        if (freeHead != NO_HUNTER) {
+            h = freeHead;
+            freeHead = page(h).next[h & PAGE_MASK];
+        } else {
+            if ((used >> PAGE_SHIFT) == pageCount) addPage();
+            h = used++;
+        }
+        Page& p = page(h);
+        HunterIndex i = h & PAGE_MASK;
+        p.id[i] = id;
+        p.aura[i] = aura;
+        p.baseFights[i] = baseFights;
+        p.block[i] = block;
+        p.next[i] = NO_HUNTER;
+        p.partial[i] = NenPacked::of(partial);
+        live += 1;
+        return h;
+    }
+
+    // h (created here, still live) is dropped; its index is reused
+    void destroy(HunterIndex h) {
+        Page& p = page(h);
+        p.block[h & PAGE_MASK] = NO_SQUAD;
+        p.next[h & PAGE_MASK] = freeHead;
+        freeHead = h;
+        live -= 1;
+    }
+
+    void releaseAll() {
+        for (HunterIndex i = 0; i < pageCount; i++) delete pages[i];
+        delete[] pages;
+        pages = nullptr;
+        pageCount = 0;
+        pageCap = 0;
+        used = 0;
+        freeHead = NO_HUNTER;
+        live = 0;
+    }
+
+    // ---- columns ----
+
+    int id(HunterIndex h) const { return page(h).id[h & PAGE_MASK]; }
+    int aura(HunterIndex h) const { return page(h).aura[h & PAGE_MASK]; }
+    int baseFights(HunterIndex h) const { return page(h).baseFights[h & PAGE_MASK]; }
+
+    SquadIndex block(HunterIndex h) const { return page(h).block[h & PAGE_MASK]; }
+    SquadIndex& block(HunterIndex h) { return page(h).block[h & PAGE_MASK]; }
+
+    HunterIndex next(HunterIndex h) const { return page(h).next[h & PAGE_MASK]; }
+    HunterIndex& next(HunterIndex h) { return page(h).next[h & PAGE_MASK]; }
+
+    NenVec partial(HunterIndex h) const { return page(h).partial[h & PAGE_MASK].unpack(); }
+};
+
+#endif // DS_WET2_WINTER_2026_01_HUNTERSTORE_H
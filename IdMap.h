@@ -0,0 +1,285 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_IDMAP_H
+#define DS_WET2_WINTER_2026_01_IDMAP_H
+
+#include <new> // std::bad_alloc
+
+#include "HashTable.h"
+#include "HuntechStats.h"
+
+// int id -> Value map that picks its layout from the keys it holds.
+//
+// Direct mode (the initial one): keys index a paged array. A page table
+// covers [0, dirSize * PAGE_SIZE); each page holds PAGE_SIZE values and a
+// presence bitmap, and is allocated when its first key arrives (freed when
+// its last key leaves). A lookup is the page pointer, one bit and the value,
+// with no hashing or probing. Runs of missing ids cost one null pointer per
+// PAGE_SIZE ids.
+//
+// Hashed mode: everything lives in a HashTable<int, Value>.
+//
+// The mode is re-checked on insert only (erase never allocates):
+// - direct -> hashed when a key is negative, or when a new page would leave
+//   the pages under 1/SPARSE_LIMIT full on average, or the page table over
+//   SPAN_LIMIT entries per allocated page (both ignored while the map is
+//   small, see MIN_PAGES / MIN_SPAN)
+// - hashed -> direct when no key is negative and [0, maxKey] is at least
+//   1/DENSE_LIMIT full; maxKey is only an upper bound after erases, which
+//   can delay the switch but never makes it wrong
+// The two thresholds are far apart, so flipping back costs Theta(size)
+// inserts/erases and the O(size) conversions stay amortized O(1).
+// A conversion that runs out of memory on insert throws std::bad_alloc with
+// the map unchanged (direct -> hashed), or keeps the map hashed.
+// forEach visits keys in no particular order. No STL containers.
+
+template <typename Value>
+class IdMap {
+private:
+    static const int PAGE_SHIFT = 10;
+    static const unsigned int PAGE_SIZE = 1u << PAGE_SHIFT;
+    static const unsigned int PAGE_MASK = PAGE_SIZE - 1;
+    static const unsigned int WORDS = PAGE_SIZE / 64;
+    static const unsigned int MAX_DIR = (0x7fffffffu >> PAGE_SHIFT) + 1;
+
+    static const long long SPARSE_LIMIT = 4;    // pages * PAGE_SIZE <= 4 * size
+    static const long long SPAN_LIMIT = 64;     // dirSize <= 64 * pages
+    static const long long MIN_PAGES = 16;
+    static const long long MIN_SPAN = 64;
+    static const long long DENSE_LIMIT = 2;     // (maxKey + 1) <= 2 * size
+
+    struct Page {
+        unsigned long long present[WORDS];
+        int count;
+        Value value[PAGE_SIZE];
+    };
+
+    bool direct;
+
+    // direct mode
+    Page** dir;              // page table
+    unsigned int dirSize;
+    long long pages;         // allocated pages
+
+    // hashed mode
+    HashTable<int, Value> hashed;
+    int maxKey;              // upper bound of the stored keys
+    long long negatives;     // stored keys < 0
+
+    long long count;
+
+private:
+    static bool has(const Page* pg, unsigned int i) {
+        return (pg->present[i >> 6] >> (i & 63)) & 1u;
+    }
+
+    static bool directFits(long long size, long long pageCount, long long span) {
+        if (pageCount > MIN_PAGES && pageCount * (long long)PAGE_SIZE > SPARSE_LIMIT * size) return false;
+        return span <= SPAN_LIMIT * pageCount + MIN_SPAN;
+    }
+
+    void releasePages() {
+        for (unsigned int p = 0; p < dirSize; p++) delete dir[p];
+        delete[] dir;
+        dir = nullptr;
+        dirSize = 0;
+        pages = 0;
+    }
+
+    void growDir(unsigned int need) {
+        unsigned int newSize = dirSize ? dirSize : 1;
+        while (newSize < need) newSize *= 2;
+        if (newSize > MAX_DIR) newSize = MAX_DIR;
+        Page** bigger = new Page*[newSize];
+        for (unsigned int p = 0; p < dirSize; p++) bigger[p] = dir[p];
+        for (unsigned int p = dirSize; p < newSize; p++) bigger[p] = nullptr;
+        delete[] dir;
+        dir = bigger;
+        dirSize = newSize;
+    }
+
+    // stores a key known to be absent in direct mode; throws std::bad_alloc
+    // before anything changes
+    void putDirect(int key, const Value& value) {
+        unsigned int k = (unsigned int)key;
+        unsigned int p = k >> PAGE_SHIFT;
+        if (p >= dirSize) growDir(p + 1);
+        Page* pg = dir[p];
+        if (!pg) {
+            pg = new Page;
+            for (unsigned int w = 0; w < WORDS; w++) pg->present[w] = 0;
+            pg->count = 0;
+            dir[p] = pg;
+            pages += 1;
+        }
+        unsigned int i = k & PAGE_MASK;
+        pg->present[i >> 6] |= 1ULL << (i & 63);
+        pg->count += 1;
+        pg->value[i] = value;
+    }
+
+    template <typename F>
+    void forEachDirect(F f) const {
+        for (unsigned int p = 0; p < dirSize; p++) {
+            const Page* pg = dir[p];
+            if (!pg) continue;
+            for (unsigned int i = 0; i < PAGE_SIZE; i++) {
+                if (has(pg, i)) f((int)((p << PAGE_SHIFT) | i), pg->value[i]);
+            }
+        }
+    }
+
+    void toHashed() {
+        HT_STAT_ADD(idToHashed, 1);
+        hashed.reserve(count + 1);
+        int top = -1;
+        try {
+            forEachDirect([&](int key, const Value& value) {
+                (void)hashed.insert(key, value);
+                if (key > top) top = key;
+            });
+        } catch (...) {
+            hashed.clear();
+            throw;
+        }
+        releasePages();
+        maxKey = top;
+        negatives = 0;
+        direct = false;
+    }
+
+    // false (map still hashed) if the pages cannot be allocated
+    bool toDirect() {
+        HT_STAT_ADD(idToDirect, 1);
+        try {
+            growDir(((unsigned int)maxKey >> PAGE_SHIFT) + 1);
+            hashed.forEach([&](const int& key, const Value& value) { putDirect(key, value); });
+        } catch (const std::bad_alloc&) {
+            releasePages();
+            return false;
+        }
+        hashed.clear();
+        direct = true;
+        return true;
+    }
+
+public:
+    IdMap()
+        : direct(true), dir(nullptr), dirSize(0), pages(0),
+          hashed(), maxKey(-1), negatives(0), count(0)
+    {
+        hashed.clear();
+    }
+
+    ~IdMap() {
+        releasePages();
+    }
+
+    IdMap(const IdMap&) = delete;
+    IdMap& operator=(const IdMap&) = delete;
+
+    // drops everything; the map is empty, direct and usable again
+    void clear() {
+        releasePages();
+        hashed.clear();
+        direct = true;
+        maxKey = -1;
+        negatives = 0;
+        count = 0;
+    }
+
+    // Room for n entries without further growth in hashed mode; direct mode
+    // allocates its pages as keys arrive.
+    void reserve(long long n) {
+        if (!direct) hashed.reserve(n);
+    }
+
+    int size() const { return (int)count; }
+    bool isEmpty() const { return count == 0; }
+    bool isDirect() const { return direct; }
+
+    Value* find(int key) {
+        return const_cast<Value*>(static_cast<const IdMap*>(this)->find(key));
+    }
+
+    const Value* find(int key) const {
+        if (!direct) return hashed.find(key);
+        HT_STAT_ADD(idDirectLookups, 1);
+        unsigned int k = (unsigned int)key;
+        unsigned int p = k >> PAGE_SHIFT;    // negative keys land past MAX_DIR
+        if (p >= dirSize) return nullptr;
+        const Page* pg = dir[p];
+        unsigned int i = k & PAGE_MASK;
+        if (!pg || !has(pg, i)) return nullptr;
+        return &pg->value[i];
+    }
+
+    // returns false if key already exists
+    bool insert(int key, const Value& value) {
+        if (find(key) != nullptr) return false;
+
+        if (direct) {
+            bool fits = key >= 0;
+            if (fits) {
+                unsigned int p = (unsigned int)key >> PAGE_SHIFT;
+                if (p >= dirSize || !dir[p]) {
+                    long long span = (p >= dirSize) ? (long long)p + 1 : (long long)dirSize;
+                    fits = directFits(count + 1, pages + 1, span);
+                }
+            }
+            if (fits) {
+                putDirect(key, value);
+                count += 1;
+                return true;
+            }
+            toHashed();
+        }
+
+        if (!hashed.insert(key, value)) return false;
+        count += 1;
+        if (key > maxKey) maxKey = key;
+        if (key < 0) negatives += 1;
+
+        if (negatives == 0 && (long long)maxKey + 1 <= DENSE_LIMIT * count) (void)toDirect();
+        return true;
+    }
+
+    // returns false if key does not exist
+    bool erase(int key) {
+        if (!direct) {
+            if (!hashed.erase(key)) return false;
+            count -= 1;
+            if (key < 0) negatives -= 1;
+            return true;
+        }
+        unsigned int k = (unsigned int)key;
+        unsigned int p = k >> PAGE_SHIFT;
+        if (p >= dirSize || !dir[p]) return false;
+        Page* pg = dir[p];
+        unsigned int i = k & PAGE_MASK;
+        if (!has(pg, i)) return false;
+        pg->present[i >> 6] &= ~(1ULL << (i & 63));
+        pg->count -= 1;
+        if (pg->count == 0) {
+            delete pg;
+            dir[p] = nullptr;
+            pages -= 1;
+        }
+        count -= 1;
+        return true;
+    }
+
+    // Visits every entry once as f(key, value), in no particular order.
+    template <typename F>
+    void forEach(F f) const {
+        if (direct) {
+            forEachDirect(f);
+        } else {
+            hashed.forEach(f);
+        }
+    }
+};
+
+#endif // DS_WET2_WINTER_2026_01_IDMAP_H
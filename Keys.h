@@ -26,4 +26,17 @@ struct AuraKeyLess {
     }
 };
 
+// AVLTree augmentation (see AVLTree.h): total collective aura of a run of
+// squads. Sums stay far below 2^63 (at most 2^31 hunters of aura < 2^31).
+struct AuraSumAugment {
+    typedef long long Summary;
+
+    static Summary identity() { return 0; }
+
+    template <typename Value>
+    static Summary of(const AuraKey& k, const Value&) { return k.aura; }
+
+    static Summary combine(Summary left, Summary right) { return left + right; }
+};
+
 #endif // DS_WET2_WINTER_2026_01_KEYS_H
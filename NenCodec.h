@@ -0,0 +1,111 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_NENCODEC_H
+#define DS_WET2_WINTER_2026_01_NENCODEC_H
+
+#include "wet2util.h"
+
+// Converts between NenAbility and its six raw counters
+// (0 = Enhancer ... 5 = Specialist) using only NenAbility's public API,
+// since wet2util.h is read-only and keeps the counters private.
+//
+// - join(): each counter is cut into 6-bit digits and every non-zero digit
+//   adds one precomputed unit(i) * digit * 64^l, so a counter below 64 costs
+//   one NenAbility addition and one below 4096 at most two (the tables are
+//   built once, 72 KiB, read-only afterwards).
+// - split(), valid values only: all counters are >= 0, and subtracting
+//   k * unit(i) keeps the value valid exactly while k <= counter(i), so each
+//   counter is found by galloping over unit(i) * 2^j. Only isValid() and
+//   subtractions that stay within [-2^30, counter] are used, so nothing in
+//   NenAbility can overflow. O(log counter) additions per counter, meant for
+//   inputs (add_hunter, bulk_load) and the replay's output writer.
+// Counters must lie in (-2^31, 2^31), i.e. not INT_MIN.
+
+class NenCodec {
+private:
+    static const int BITS = 31;
+    static const int DIGIT_BITS = 6;
+    static const int DIGIT_SIZE = 1 << DIGIT_BITS;
+    static const int DIGIT_MASK = DIGIT_SIZE - 1;
+    static const int DIGITS = (BITS + DIGIT_BITS - 1) / DIGIT_BITS;
+
+    NenAbility units[6][BITS];                   // unit(i) * 2^j
+    NenAbility digits[6][DIGITS][DIGIT_SIZE];    // unit(i) * x * 64^l (only entries below 2^31)
+
+    NenCodec() {
+        static const char* names[6] = {
+            "Enhancer", "Emitter", "Transmuter", "Conjurer", "Manipulator", "Specialist"
+        };
+        for (int i = 0; i < 6; i++) {
+            units[i][0] = NenAbility(names[i]);
+            for (int j = 1; j < BITS; j++) units[i][j] = units[i][j - 1] + units[i][j - 1];
+
+            for (int l = 0; l < DIGITS; l++) {
+                int shift = l * DIGIT_BITS;
+                if (shift >= BITS) break;
+                for (long long x = 1; x < DIGIT_SIZE && (x << shift) < (1LL << BITS); x++) {
+                    digits[i][l][x] = digits[i][l][x - 1] + units[i][shift];
+                }
+            }
+        }
+    }
+
+    // t valid; returns counter i and leaves it at 0 in t
+    int drain(NenAbility& t, int i) const {
+        int k = 0;
+        int j = 0;
+        while (j < BITS && (t - units[i][j]).isValid()) {
+            t -= units[i][j];
+            k += (1 << j);
+            j++;
+        }
+        while (j-- > 0) {
+            if ((t - units[i][j]).isValid()) {
+                t -= units[i][j];
+                k += (1 << j);
+            }
+        }
+        return k;
+    }
+
+    // adds unit(i) * m
+    void addScaled(NenAbility& acc, int i, unsigned long long m) const {
+        for (int l = 0; m != 0; l++, m >>= DIGIT_BITS) {
+            unsigned x = (unsigned)(m & DIGIT_MASK);
+            if (x != 0) acc += digits[i][l][x];
+        }
+    }
+
+public:
+    static const NenCodec& instance() {
+        static const NenCodec codec;
+        return codec;
+    }
+
+    // a must be valid (a.isValid())
+    void split(const NenAbility& a, int out[6]) const {
+        NenAbility t = a;
+        for (int i = 0; i < 6; i++) out[i] = drain(t, i);
+    }
+
+    NenAbility join(const int in[6]) const {
+        NenAbility pos;
+        NenAbility neg;
+        bool anyNeg = false;
+        for (int i = 0; i < 6; i++) {
+            long long v = in[i];
+            if (v < 0) {
+                addScaled(neg, i, (unsigned long long)-v);
+                anyNeg = true;
+            } else {
+                addScaled(pos, i, (unsigned long long)v);
+            }
+        }
+        if (anyNeg) pos -= neg;
+        return pos;
+    }
+};
+
+#endif // DS_WET2_WINTER_2026_01_NENCODEC_H
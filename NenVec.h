@@ -0,0 +1,143 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_NENVEC_H
+#define DS_WET2_WINTER_2026_01_NENVEC_H
+
+#include <type_traits> // std::is_trivially_copyable
+
+#include "NenCodec.h"
+
+// Internal Nen vector used by Squad/Hunter/DSU instead of NenAbility.
+//
+// NenAbility has a virtual destructor (a vptr in every copy) and user-written
+// copy operations; NenVec is a plain aggregate of eight ints in one 32-byte
+// aligned block (counters 0..5 in NenAbility order, lanes 6..7 always 0), so
+// copies are a single 32-byte move and the fixed-length add/sub loops are
+// vectorized by the compiler (two SSE2 ops, or one AVX2 op with -mavx2).
+//
+// Arithmetic is done modulo 2^32 and cast back to int, which gives exactly
+// the values NenAbility's int arithmetic produces whenever those are defined.
+// Conversion from/to NenAbility (NenCodec) happens only at the API boundary:
+// fromAbility() on valid inputs, toAbility() on query results (one
+// NenAbility addition per non-zero 6-bit digit of each counter).
+
+// Same matchup matrix as NenAbility::getNenMatrix() (wet2util.h), as a
+// compile-time table so the comparator below is folded into adds/subs.
+static constexpr int NEN_DUEL_MATRIX[6][6] = {
+    // E   Em  Tr  Co  Ma  Sp
+    {  0, +1, +1, -1, -1, -1 }, // Enhancer
+    { -1,  0, +1, +1, -1, -1 }, // Emitter
+    { -1, -1,  0, +1, +1, -1 }, // Transmuter
+    { +1, -1, -1,  0, +1, -1 }, // Conjurer
+    { +1, +1, -1, -1,  0, -1 }, // Manipulator
+    { +1, +1, +1, +1, +1,  0 }  // Specialist
+};
+
+struct alignas(32) NenVec {
+    static const int LANES = 8;
+
+    int c[LANES];
+
+    static NenVec zero() {
+        NenVec v;
+        for (int i = 0; i < LANES; i++) v.c[i] = 0;
+        return v;
+    }
+
+    // a must be valid
+    static NenVec fromAbility(const NenAbility& a) {
+        NenVec v = zero();
+        NenCodec::instance().split(a, v.c);
+        return v;
+    }
+
+    NenAbility toAbility() const {
+        return NenCodec::instance().join(c);
+    }
+
+    NenVec& operator+=(const NenVec& o) {
+        for (int i = 0; i < LANES; i++) c[i] = (int)((unsigned)c[i] + (unsigned)o.c[i]);
+        return *this;
+    }
+
+    NenVec& operator-=(const NenVec& o) {
+        for (int i = 0; i < LANES; i++) c[i] = (int)((unsigned)c[i] - (unsigned)o.c[i]);
+        return *this;
+    }
+
+    friend NenVec operator+(const NenVec& a, const NenVec& b) {
+        NenVec r = a;
+        r += b;
+        return r;
+    }
+
+    friend NenVec operator-(const NenVec& a, const NenVec& b) {
+        NenVec r = a;
+        r -= b;
+        return r;
+    }
+
+    // NenAbility::getEffectiveNenAbility()
+    int effective() const {
+        unsigned sum = 0;
+        for (int i = 0; i < 6; i++) sum += (unsigned)c[i] * (unsigned)c[i];
+        return (int)sum;
+    }
+
+    // NenAbility::compareNenTypes(a, b) = sum_ij a_i * M_ij * b_j, computed as
+    // a . (M b): M's entries are compile-time +-1/0, so M b is 30 adds/subs
+    // and only the final dot product multiplies (6 instead of 36).
+    static int duelScore(const NenVec& a, const NenVec& b) {
+        unsigned score = 0;
+        for (int i = 0; i < 6; i++) {
+            unsigned mb = 0;
+            for (int j = 0; j < 6; j++) {
+                if (NEN_DUEL_MATRIX[i][j] > 0) mb += (unsigned)b.c[j];
+                else if (NEN_DUEL_MATRIX[i][j] < 0) mb -= (unsigned)b.c[j];
+            }
+            score += (unsigned)a.c[i] * mb;
+        }
+        return (int)score;
+    }
+
+    bool operator>(const NenVec& o) const { return duelScore(*this, o) > 0; }
+    bool operator<(const NenVec& o) const { return duelScore(*this, o) < 0; }
+};
+
+static_assert(std::is_trivially_copyable<NenVec>::value, "NenVec must stay trivially copyable");
+static_assert(sizeof(NenVec) == 32, "NenVec must be one 32-byte block");
+
+// The six counters of a NenVec without the padding lanes and the 32-byte
+// alignment, for per-hunter/per-squad storage where 24 bytes per entry
+// matter more than aligned loads (same modulo-2^32 arithmetic).
+struct NenPacked {
+    int c[6];
+
+    static NenPacked of(const NenVec& v) {
+        NenPacked p;
+        for (int i = 0; i < 6; i++) p.c[i] = v.c[i];
+        return p;
+    }
+
+    NenVec unpack() const {
+        NenVec v = NenVec::zero();
+        for (int i = 0; i < 6; i++) v.c[i] = c[i];
+        return v;
+    }
+
+    NenPacked& operator+=(const NenVec& v) {
+        for (int i = 0; i < 6; i++) c[i] = (int)((unsigned)c[i] + (unsigned)v.c[i]);
+        return *this;
+    }
+
+    NenPacked& operator-=(const NenVec& v) {
+        for (int i = 0; i < 6; i++) c[i] = (int)((unsigned)c[i] - (unsigned)v.c[i]);
+        return *this;
+    }
+};
+
+static_assert(sizeof(NenPacked) == 24, "NenPacked must be six packed ints");
+
+#endif // DS_WET2_WINTER_2026_01_NENVEC_H
@@ -0,0 +1,256 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_NODEPOOL_H
+#define DS_WET2_WINTER_2026_01_NODEPOOL_H
+
+#include <new> // placement new, std::bad_alloc
+
+// Slab allocator that hands out 32-bit handles instead of raw pointers.
+//
+// - Storage grows in fixed-size slabs; a slab is never moved or reallocated,
+//   so the address behind a handle stays valid until it is released.
+// - Freed slots are kept on an intrusive free list (the handle of the next
+//   free slot is written into the slot itself) and reused before any new slab.
+// - releaseAll() drops every slab in one go without visiting the objects,
+//   so it must only be used when T needs no destructor call
+//   (or after the caller destroyed the live objects itself).
+//
+// Handle 0 is reserved as the null handle. No STL containers.
+
+template <typename T, int SlabShift = 10>
+class NodePool {
+public:
+    typedef unsigned int Handle;
+    static const Handle NIL = 0;
+
+private:
+    static const unsigned int SLAB_SIZE = 1u << SlabShift;
+    static const unsigned int SLAB_MASK = SLAB_SIZE - 1;
+
+    union Slot {
+        alignas(T) unsigned char raw[sizeof(T)];
+        Handle nextFree;
+    };
+
+    Slot** slabs;          // slab table (only this small array is ever resized)
+    unsigned int slabCount;
+    unsigned int slabCap;
+    Handle freeHead;       // head of the free list, NIL if empty
+    Handle nextFresh;      // first never-used handle
+    unsigned int live;     // number of allocated objects
+
+private:
+    Slot& slot(Handle h) const {
+        return slabs[h >> SlabShift][h & SLAB_MASK];
+    }
+
+    void addSlab() {
+        if (slabCount == slabCap) {
+            unsigned int newCap = slabCap ? slabCap * 2 : 8;
+            Slot** bigger = new Slot*[newCap];
+            for (unsigned int i = 0; i < slabCount; i++) bigger[i] = slabs[i];
+            delete[] slabs;
+            slabs = bigger;
+            slabCap = newCap;
+        }
+        slabs[slabCount] = new Slot[SLAB_SIZE];
+        slabCount += 1;
+    }
+
+    Handle takeSlot() {
+        if (freeHead != NIL) {
+            Handle h = freeHead;
+            freeHead = slot(h).nextFree;
+            return h;
+        }
+        if ((nextFresh >> SlabShift) == slabCount) {
+            if (slabCount == (1u << (32 - SlabShift)) - 1) throw std::bad_alloc();
+            addSlab();
+        }
+        return nextFresh++;
+    }
+
+public:
+    NodePool()
+        : slabs(nullptr), slabCount(0), slabCap(0),
+          freeHead(NIL), nextFresh(1), live(0) {}
+
+    ~NodePool() { releaseAll(); }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    int size() const { return (int)live; }
+
+    T& at(Handle h) { return *reinterpret_cast<T*>(slot(h).raw); }
+    const T& at(Handle h) const { return *reinterpret_cast<const T*>(slot(h).raw); }
+
+    // Constructs a T in a free slot (copy-construct from proto).
+    Handle create(const T& proto) {
+        Handle h = takeSlot();
+        try {
+            new (slot(h).raw) T(proto);
+        } catch (...) {
+            slot(h).nextFree = freeHead;
+            freeHead = h;
+            throw;
+        }
+        live += 1;
+        return h;
+    }
+
+    void destroy(Handle h) {
+        at(h).~T();
+        slot(h).nextFree = freeHead;
+        freeHead = h;
+        live -= 1;
+    }
+
+    // Drops all slabs at once. Live objects are NOT destructed.
+    void releaseAll() {
+        for (unsigned int i = 0; i < slabCount; i++) delete[] slabs[i];
+        delete[] slabs;
+        slabs = nullptr;
+        slabCount = 0;
+        slabCap = 0;
+        freeHead = NIL;
+        nextFresh = 1;
+        live = 0;
+    }
+};
+
+template <typename T, int SlabShift>
+const typename NodePool<T, SlabShift>::Handle NodePool<T, SlabShift>::NIL;
+
+// Same interface as NodePool (plus reserve), but the slab table never moves:
+// a fixed directory of slab-table blocks, each allocated once and kept until
+// releaseAll(). A thread that was handed a handle can keep reading the
+// object behind it while the owner creates and destroys other objects
+// (PersistentAVLTree snapshots); with NodePool, growing the slab table
+// would move it under such a reader.
+
+template <typename T, int SlabShift = 10>
+class StableNodePool {
+public:
+    typedef unsigned int Handle;
+    static const Handle NIL = 0;
+
+private:
+    static const unsigned int SLAB_SIZE = 1u << SlabShift;
+    static const unsigned int SLAB_MASK = SLAB_SIZE - 1;
+    static const int BLOCK_SHIFT = 11;
+    static const unsigned int BLOCK_SIZE = 1u << BLOCK_SHIFT;   // slabs per block
+    static const unsigned int BLOCK_MASK = BLOCK_SIZE - 1;
+    static const unsigned int DIR_SIZE = 1u << (32 - SlabShift - BLOCK_SHIFT);
+
+    union Slot {
+        alignas(T) unsigned char raw[sizeof(T)];
+        Handle nextFree;
+    };
+
+    Slot*** dir;           // DIR_SIZE blocks of BLOCK_SIZE slabs, allocated on demand
+    unsigned int slabCount;
+    Handle freeHead;
+    unsigned int freeCount;
+    Handle nextFresh;
+    unsigned int live;
+
+private:
+    Slot& slot(Handle h) const {
+        return dir[h >> (SlabShift + BLOCK_SHIFT)][(h >> SlabShift) & BLOCK_MASK][h & SLAB_MASK];
+    }
+
+    void addSlab() {
+        if (slabCount == (1u << (32 - SlabShift)) - 1) throw std::bad_alloc();
+        if (!dir) {
+            dir = new Slot**[DIR_SIZE];
+            for (unsigned int i = 0; i < DIR_SIZE; i++) dir[i] = nullptr;
+        }
+        Slot**& block = dir[slabCount >> BLOCK_SHIFT];
+        if (!block) block = new Slot*[BLOCK_SIZE];
+        block[slabCount & BLOCK_MASK] = new Slot[SLAB_SIZE];
+        slabCount += 1;
+    }
+
+    Handle takeSlot() {
+        if (freeHead != NIL) {
+            Handle h = freeHead;
+            freeHead = slot(h).nextFree;
+            freeCount -= 1;
+            return h;
+        }
+        if ((nextFresh >> SlabShift) == slabCount) addSlab();
+        return nextFresh++;
+    }
+
+public:
+    StableNodePool()
+        : dir(nullptr), slabCount(0), freeHead(NIL), freeCount(0), nextFresh(1), live(0) {}
+
+    ~StableNodePool() { releaseAll(); }
+
+    StableNodePool(const StableNodePool&) = delete;
+    StableNodePool& operator=(const StableNodePool&) = delete;
+
+    int size() const { return (int)live; }
+
+    T& at(Handle h) { return *reinterpret_cast<T*>(slot(h).raw); }
+    const T& at(Handle h) const { return *reinterpret_cast<const T*>(slot(h).raw); }
+
+    // Makes sure the next n create() calls need no allocation (they cannot
+    // throw unless T's copy constructor does).
+    void reserve(unsigned int n) {
+        while (true) {
+            unsigned long long fresh = ((unsigned long long)slabCount << SlabShift) - nextFresh;
+            if (slabCount == 0) fresh = 0;
+            if (freeCount + fresh >= n) return;
+            addSlab();
+        }
+    }
+
+    Handle create(const T& proto) {
+        Handle h = takeSlot();
+        try {
+            new (slot(h).raw) T(proto);
+        } catch (...) {
+            slot(h).nextFree = freeHead;
+            freeHead = h;
+            freeCount += 1;
+            throw;
+        }
+        live += 1;
+        return h;
+    }
+
+    void destroy(Handle h) {
+        at(h).~T();
+        slot(h).nextFree = freeHead;
+        freeHead = h;
+        freeCount += 1;
+        live -= 1;
+    }
+
+    // Drops all slabs at once. Live objects are NOT destructed.
+    void releaseAll() {
+        for (unsigned int i = 0; i < slabCount; i++) {
+            delete[] dir[i >> BLOCK_SHIFT][i & BLOCK_MASK];
+        }
+        if (dir) {
+            for (unsigned int i = 0; i < DIR_SIZE; i++) delete[] dir[i];
+            delete[] dir;
+        }
+        dir = nullptr;
+        slabCount = 0;
+        freeHead = NIL;
+        freeCount = 0;
+        nextFresh = 1;
+        live = 0;
+    }
+};
+
+template <typename T, int SlabShift>
+const typename StableNodePool<T, SlabShift>::Handle StableNodePool<T, SlabShift>::NIL;
+
+#endif // DS_WET2_WINTER_2026_01_NODEPOOL_H
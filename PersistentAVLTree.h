@@ -0,0 +1,490 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_PERSISTENTAVLTREE_H
+#define DS_WET2_WINTER_2026_01_PERSISTENTAVLTREE_H
+
+#include <atomic>
+#include <new> // std::bad_alloc
+#include <type_traits> // std::is_trivially_destructible
+
+#include "AVLTree.h" // DefaultLess
+#include "NodePool.h"
+
+// AVL tree with subtree sizes whose versions can be kept: snapshot() takes
+// an O(1) read-only handle on the current content, and later updates
+// path-copy the O(log n) nodes they would change instead of writing to
+// nodes a snapshot can still reach.
+//
+// Every node counts its references (parent nodes, the live root, versions).
+// A node with a count of 1 on a path from the live root is reachable only
+// from the live tree and is updated in place, so without snapshots an update
+// copies nothing. A version is reclaimed once its last Snapshot is released
+// or destroyed: its root loses a reference and every node left with none is
+// freed (the dead ones are chained through their count field).
+//
+// Threads: one writer calls every tree method; a Snapshot may be read and
+// released on any thread (hand it over with the usual synchronization:
+// thread start, a queue, a lock). Readers never block the writer and the
+// writer never blocks readers: nodes a snapshot reaches are never written
+// and are freed only after its release, and StableNodePool keeps their
+// addresses valid while the pool grows. Releases only decrement an atomic
+// count; the writer frees the dead versions at its next update (or in
+// reclaim()). Every Snapshot must be released before the tree is destroyed.
+//
+// Updates reserve their worst-case node count before touching anything, so
+// a std::bad_alloc leaves the tree unchanged. No STL containers.
+
+template <typename Key, typename Value, typename Less = DefaultLess<Key>>
+class PersistentAVLTree {
+public:
+    typedef unsigned int Handle;
+
+    struct Node {
+        Key key;
+        Value value;
+        int height;
+        int subSize;
+        Handle left;
+        Handle right;
+        unsigned int refs;   // writer only; next dead node while freeing
+
+        Node(const Key& k, const Value& v)
+            : key(k), value(v), height(1), subSize(1), left(0), right(0), refs(1) {}
+    };
+
+private:
+    typedef StableNodePool<Node> Pool;
+    static const Handle NIL = Pool::NIL;
+
+    // An AVL tree with < 2^32 nodes is less than 1.45 * 32 levels deep.
+    static const int MAX_HEIGHT = 64;
+
+    struct Version {
+        Handle root;                 // holds one reference
+        std::atomic<int> holders;    // Snapshot objects on this version
+        Version* next;
+    };
+
+    Pool pool;
+    Handle root;                     // live tree, holds one reference
+    Less less;
+    Version* versions;               // taken and not yet reclaimed (writer)
+    mutable std::atomic<int> released;   // versions with no holder left
+
+private:
+    Node& at(Handle n) { return pool.at(n); }
+    const Node& at(Handle n) const { return pool.at(n); }
+
+    int h(Handle n) const { return n ? at(n).height : 0; }
+    int sz(Handle n) const { return n ? at(n).subSize : 0; }
+    static int max2(int a, int b) { return (a > b) ? a : b; }
+
+    void recalc(Handle n) {
+        Node& x = at(n);
+        x.height  = 1 + max2(h(x.left), h(x.right));
+        x.subSize = 1 + sz(x.left) + sz(x.right);
+    }
+
+    int balanceFactor(Handle n) const {
+        return n ? (h(at(n).left) - h(at(n).right)) : 0;
+    }
+
+    // Drops one reference to n; frees n and, transitively, every node whose
+    // last reference it held.
+    void unref(Handle n) {
+        if (!n || --at(n).refs > 0) return;
+        Handle dead = n;   // at(x).refs links the dead nodes
+        at(n).refs = NIL;
+        while (dead) {
+            Handle x = dead;
+            dead = at(x).refs;
+            Handle kids[2] = {at(x).left, at(x).right};
+            for (int i = 0; i < 2; i++) {
+                Handle c = kids[i];
+                if (c && --at(c).refs == 0) {
+                    at(c).refs = dead;
+                    dead = c;
+                }
+            }
+            pool.destroy(x);
+        }
+    }
+
+    // The caller holds a reference to n and is itself writable. Returns n
+    // when that reference is the only one, else a private copy of n; the
+    // result carries the caller's reference and may be written.
+    Handle own(Handle n) {
+        if (at(n).refs == 1) return n;
+        Handle c = pool.create(at(n));
+        Node& x = at(c);
+        x.refs = 1;
+        if (x.left) at(x.left).refs += 1;
+        if (x.right) at(x.right).refs += 1;
+        at(n).refs -= 1;   // still > 0: a snapshot keeps n
+        return c;
+    }
+
+    // Upper bound on the nodes one insert/remove creates: the search path,
+    // plus up to two rotation partners per level on the way back up.
+    unsigned int updateBudget() const { return 3u * (unsigned int)(h(root) + 2); }
+
+    // Rotations take and return one reference, like own().
+    Handle rotateRight(Handle y) {
+        y = own(y);
+        Handle x = own(at(y).left);
+        at(y).left = at(x).right;
+        at(x).right = y;
+
+        recalc(y);
+        recalc(x);
+        return x;
+    }
+
+    Handle rotateLeft(Handle x) {
+        x = own(x);
+        Handle y = own(at(x).right);
+        at(x).right = at(y).left;
+        at(y).left = x;
+
+        recalc(x);
+        recalc(y);
+        return y;
+    }
+
+    // n is writable
+    Handle rebalance(Handle n) {
+        recalc(n);
+        int bf = balanceFactor(n);
+
+        // Left heavy
+        if (bf > 1) {
+            if (balanceFactor(at(n).left) < 0) {
+                Handle l = rotateLeft(at(n).left);
+                at(n).left = l;
+            }
+            return rotateRight(n);
+        }
+
+        // Right heavy
+        if (bf < -1) {
+            if (balanceFactor(at(n).right) > 0) {
+                Handle r = rotateRight(at(n).right);
+                at(n).right = r;
+            }
+            return rotateLeft(n);
+        }
+
+        return n;
+    }
+
+    // key is not in the subtree
+    Handle insertRec(Handle n, const Key& key, const Value& value) {
+        if (!n) return pool.create(Node(key, value));
+
+        Handle x = own(n);
+        if (less(key, at(x).key)) {
+            Handle l = insertRec(at(x).left, key, value);
+            at(x).left = l;
+        } else {
+            Handle r = insertRec(at(x).right, key, value);
+            at(x).right = r;
+        }
+        return rebalance(x);
+    }
+
+    Handle minNode(Handle n) const {
+        Handle cur = n;
+        while (cur && at(cur).left) cur = at(cur).left;
+        return cur;
+    }
+
+    // key is in the subtree
+    Handle removeRec(Handle n, const Key& key) {
+        Handle x = own(n);
+        if (less(key, at(x).key)) {
+            Handle l = removeRec(at(x).left, key);
+            at(x).left = l;
+        } else if (less(at(x).key, key)) {
+            Handle r = removeRec(at(x).right, key);
+            at(x).right = r;
+        } else {
+            // 0 or 1 child: the child takes x's place with x's reference
+            if (!at(x).left || !at(x).right) {
+                Handle child = at(x).left ? at(x).left : at(x).right;
+                at(x).left = NIL;
+                at(x).right = NIL;
+                unref(x);
+                return child;
+            }
+
+            // 2 children: replace with successor key/value
+            Handle succ = minNode(at(x).right);
+            at(x).key = at(succ).key;
+            at(x).value = at(succ).value;
+
+            Handle r = removeRec(at(x).right, at(x).key);
+            at(x).right = r;
+        }
+        return rebalance(x);
+    }
+
+    Handle buildRec(const Key* keys, const Value* values, int lo, int hi) {
+        if (lo >= hi) return NIL;
+        int mid = lo + (hi - lo) / 2;
+
+        Handle n = pool.create(Node(keys[mid], values[mid]));
+        Handle l = buildRec(keys, values, lo, mid);
+        Handle r = buildRec(keys, values, mid + 1, hi);
+        at(n).left = l;
+        at(n).right = r;
+        recalc(n);
+        return n;
+    }
+
+    // ---- read-only walks over one version ----
+
+    Handle findIn(Handle cur, const Key& key) const {
+        while (cur) {
+            if (less(key, at(cur).key)) {
+                cur = at(cur).left;
+            } else if (less(at(cur).key, key)) {
+                cur = at(cur).right;
+            } else {
+                return cur;
+            }
+        }
+        return NIL;
+    }
+
+    const Node* selectIn(Handle cur, int k) const {
+        if (k <= 0 || k > sz(cur)) return nullptr;
+        while (cur) {
+            int leftSize = sz(at(cur).left);
+            if (k == leftSize + 1) return &at(cur);
+
+            if (k <= leftSize) {
+                cur = at(cur).left;
+            } else {
+                k -= (leftSize + 1);
+                cur = at(cur).right;
+            }
+        }
+        return nullptr;
+    }
+
+    int countLessIn(Handle cur, const Key& key) const {
+        int below = 0;
+        while (cur) {
+            if (less(at(cur).key, key)) {
+                below += sz(at(cur).left) + 1;
+                cur = at(cur).right;
+            } else {
+                cur = at(cur).left;
+            }
+        }
+        return below;
+    }
+
+    int rankIn(Handle cur, const Key& key) const {
+        int below = 0;
+        while (cur) {
+            if (less(key, at(cur).key)) {
+                cur = at(cur).left;
+            } else if (less(at(cur).key, key)) {
+                below += sz(at(cur).left) + 1;
+                cur = at(cur).right;
+            } else {
+                return below + sz(at(cur).left) + 1;
+            }
+        }
+        return 0;
+    }
+
+    template <typename F>
+    void forEachIn(Handle cur, F& f) const {
+        Handle stack[MAX_HEIGHT];
+        int top = 0;
+        while (cur || top > 0) {
+            while (cur) {
+                stack[top++] = cur;
+                cur = at(cur).left;
+            }
+            cur = stack[--top];
+            f(at(cur).key, at(cur).value);
+            cur = at(cur).right;
+        }
+    }
+
+public:
+    // Read-only view of one version. Default-constructed or released
+    // snapshots are empty. Movable, not copyable.
+    class Snapshot {
+    private:
+        friend class PersistentAVLTree;
+
+        const PersistentAVLTree* tree;
+        Version* version;
+
+        Snapshot(const PersistentAVLTree* t, Version* v) : tree(t), version(v) {}
+
+        Handle top() const { return version ? version->root : NIL; }
+
+    public:
+        Snapshot() : tree(nullptr), version(nullptr) {}
+        ~Snapshot() { release(); }
+
+        Snapshot(Snapshot&& other) : tree(other.tree), version(other.version) {
+            other.tree = nullptr;
+            other.version = nullptr;
+        }
+
+        Snapshot& operator=(Snapshot&& other) {
+            if (this != &other) {
+                release();
+                tree = other.tree;
+                version = other.version;
+                other.tree = nullptr;
+                other.version = nullptr;
+            }
+            return *this;
+        }
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        bool valid() const { return version != nullptr; }
+
+        // Gives the version back to the writer (any thread).
+        void release() {
+            if (!version) return;
+            if (version->holders.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                tree->released.fetch_add(1, std::memory_order_release);
+            }
+            tree = nullptr;
+            version = nullptr;
+        }
+
+        int size() const { return version ? tree->sz(top()) : 0; }
+
+        // 1-indexed in-order select. nullptr if out of range.
+        const Node* select(int k) const { return version ? tree->selectIn(top(), k) : nullptr; }
+
+        const Value* find(const Key& key) const {
+            if (!version) return nullptr;
+            Handle n = tree->findIn(top(), key);
+            return n ? &tree->at(n).value : nullptr;
+        }
+
+        // 1-indexed rank of key, 0 if not present.
+        int rank(const Key& key) const { return version ? tree->rankIn(top(), key) : 0; }
+
+        // Number of keys strictly less than key.
+        int countLess(const Key& key) const { return version ? tree->countLessIn(top(), key) : 0; }
+
+        template <typename F>
+        void forEachInOrder(F f) const {
+            if (version) tree->forEachIn(top(), f);
+        }
+    };
+
+    PersistentAVLTree() : pool(), root(NIL), less(Less()), versions(nullptr), released(0) {}
+
+    ~PersistentAVLTree() {
+        while (versions) {
+            Version* v = versions;
+            versions = v->next;
+            if (!std::is_trivially_destructible<Node>::value) unref(v->root);
+            delete v;
+        }
+        if (!std::is_trivially_destructible<Node>::value) unref(root);
+        pool.releaseAll();
+    }
+
+    PersistentAVLTree(const PersistentAVLTree&) = delete;
+    PersistentAVLTree& operator=(const PersistentAVLTree&) = delete;
+
+    int size() const { return sz(root); }
+    bool isEmpty() const { return root == NIL; }
+
+    // Nodes alive across the live tree and all unreclaimed versions.
+    int nodeCount() const { return pool.size(); }
+
+    // O(1). Throws std::bad_alloc (tree unchanged).
+    Snapshot snapshot() {
+        reclaim();
+        Version* v = new Version;
+        v->root = root;
+        v->holders.store(1, std::memory_order_relaxed);
+        v->next = versions;
+        versions = v;
+        if (root) at(root).refs += 1;
+        return Snapshot(this, v);
+    }
+
+    // Frees the versions whose snapshots were all released. Called by every
+    // update; O(#unreclaimed versions) when there is something to free.
+    void reclaim() {
+        if (released.load(std::memory_order_acquire) == 0) return;
+        Version** link = &versions;
+        while (*link) {
+            Version* v = *link;
+            if (v->holders.load(std::memory_order_acquire) == 0) {
+                *link = v->next;
+                unref(v->root);
+                delete v;
+                released.fetch_sub(1, std::memory_order_relaxed);
+            } else {
+                link = &v->next;
+            }
+        }
+    }
+
+    // returns false if key already exists
+    bool insert(const Key& key, const Value& value) {
+        reclaim();
+        if (findIn(root, key)) return false;
+        pool.reserve(updateBudget());
+        root = insertRec(root, key, value);
+        return true;
+    }
+
+    // returns false if key didn't exist
+    bool remove(const Key& key) {
+        reclaim();
+        if (!findIn(root, key)) return false;
+        pool.reserve(updateBudget());
+        root = removeRec(root, key);
+        return true;
+    }
+
+    // Empties the live tree; snapshots keep their content.
+    void clear() {
+        reclaim();
+        Handle old = root;
+        root = NIL;
+        unref(old);
+    }
+
+    // Replaces the live content with n entries whose keys are strictly
+    // increasing, O(n). Returns false (tree unchanged) if they are not.
+    bool buildFromSorted(const Key* keys, const Value* values, int n) {
+        for (int i = 1; i < n; i++) {
+            if (!less(keys[i - 1], keys[i])) return false;
+        }
+        pool.reserve(n > 0 ? (unsigned int)n : 0u);
+        clear();
+        root = buildRec(keys, values, 0, n);
+        return true;
+    }
+
+    const Value* find(const Key& key) const {
+        Handle n = findIn(root, key);
+        return n ? &at(n).value : nullptr;
+    }
+
+    const Node* select(int k) const { return selectIn(root, k); }
+};
+
+#endif // DS_WET2_WINTER_2026_01_PERSISTENTAVLTREE_H
@@ -0,0 +1,53 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_RADIXSORT_H
+#define DS_WET2_WINTER_2026_01_RADIXSORT_H
+
+// Stable LSD radix sort of an index permutation by unsigned 64-bit keys.
+//
+// order[0..n) holds indices into keys[]; on return it is ordered by
+// keys[order[i]] ascending, equal keys keeping their previous relative order
+// (so sorting by a secondary key first and a primary key second yields a
+// lexicographic order). tmp must hold n ints.
+//
+// 8-bit digits; a pass whose digit is the same for every key is skipped, so
+// small keys (ids, auras) cost only as many passes as they have bytes.
+// O(passes * (n + 256)). No STL containers.
+
+inline void radixSortIndices(const unsigned long long* keys, int* order, int* tmp, int n) {
+    if (n < 2) return;
+
+    unsigned long long any = 0;
+    unsigned long long all = ~0ULL;
+    for (int i = 0; i < n; i++) {
+        any |= keys[i];
+        all &= keys[i];
+    }
+    const unsigned long long varying = any & ~all;
+
+    int* src = order;
+    int* dst = tmp;
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xFFULL) == 0) continue;
+
+        int count[257] = { 0 };
+        for (int i = 0; i < n; i++) count[((keys[src[i]] >> shift) & 0xFFULL) + 1] += 1;
+        for (int d = 0; d < 256; d++) count[d + 1] += count[d];
+        for (int i = 0; i < n; i++) {
+            int d = (int)((keys[src[i]] >> shift) & 0xFFULL);
+            dst[count[d]++] = src[i];
+        }
+
+        int* t = src;
+        src = dst;
+        dst = t;
+    }
+
+    if (src != order) {
+        for (int i = 0; i < n; i++) order[i] = src[i];
+    }
+}
+
+#endif // DS_WET2_WINTER_2026_01_RADIXSORT_H
@@ -0,0 +1,31 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_SCRATCHARRAY_H
+#define DS_WET2_WINTER_2026_01_SCRATCHARRAY_H
+
+#include <new> // std::bad_alloc
+
+// Owning fixed-size temporary array for bulk operations (snapshot restore,
+// bulk load). Freed on every exit path, including a thrown std::bad_alloc.
+// No STL containers.
+
+template <typename T>
+class ScratchArray {
+private:
+    T* items;
+
+public:
+    explicit ScratchArray(long long n) : items(new T[n > 0 ? n : 1]) {}
+    ~ScratchArray() { delete[] items; }
+
+    ScratchArray(const ScratchArray&) = delete;
+    ScratchArray& operator=(const ScratchArray&) = delete;
+
+    T* data() { return items; }
+    T& operator[](long long i) { return items[i]; }
+    const T& operator[](long long i) const { return items[i]; }
+};
+
+#endif // DS_WET2_WINTER_2026_01_SCRATCHARRAY_H
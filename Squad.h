@@ -5,51 +5,75 @@
 #ifndef DS_WET2_WINTER_2026_01_SQUAD_H
 #define DS_WET2_WINTER_2026_01_SQUAD_H
 
-#include "wet2util.h"
+#include "DenseIndex.h"
+#include "NenVec.h"
 
-// A Squad object is both:
-// 1) the entity stored in active squad trees
-// 2) a DSU node (for force-join chaining without updating all hunters)
+// Every squad ever created is a DSU node (force-join chains sets without
+// updating their hunters), split in two records under the same SquadIndex
+// (SquadStore.h):
+// 1) DsuNode: the link and the potentials, all a find walk reads
+// 2) Squad: the aggregates of an active squad, only meaningful at a DSU root
 //
 // DSU "potentials":
-// - fightOffsetToParent: integer offset so hunters keep correct fights after joins
-// - nenOffsetToParent: NenAbility offset representing the prefix added before this block
+// - fightOffset: integer offset so hunters keep correct fights after joins
+// - nenOffset: Nen offset representing the prefix added before this block
+// At a root the same two fields hold the set's lazy terms (+1 fights to all
+// hunters of the set, Nen prefix added to all of them), so a hunter's
+// potential is the sum of the offsets on its path, root included.
 //
-// Only DSU roots use fightsAddRoot (lazy +1 to all hunters in that root).
+// Union is by size, so the DSU root of a set is not necessarily the squad
+// that survived force_join. The root's `id` is therefore the id of the active
+// squad the whole set represents (squadsById maps that id to the root).
+//
+// The members of a set can be enumerated without a full scan: the root
+// keeps the tail of a circular list of the set's hunters (HunterStore's next
+// column, in join order), and the DSU nodes of a set form a cycle through
+// Squad::nextInSet (two cycles merge by swapping one link of each).
+
+struct alignas(32) DsuNode {
+    SquadIndex parent;     // NO_SQUAD at a root
+    int fightOffset;       // to the parent; at a root, lazy fights of the set
+    NenPacked nenOffset;   // to the parent; at a root, lazy prefix of the set
+};
+
+static_assert(sizeof(DsuNode) == 32, "DsuNode must stay two per cache line");
 
 struct Squad {
+    NenPacked nenSum;
+    long long auraSum;
+
+    // only meaningful at DSU root: last hunter of the set's circular list
+    HunterIndex lastHunter;
+    SquadIndex nextInSet;      // cycle of the DSU nodes of the set
+
     int id;
-    bool alive;      // false means the squad (and all its hunters) are "dead"
+    int index;       // record number in the last saved snapshot (-1: never saved)
     int experience;
-
     int huntersCount;
-    long long auraSum;
-    NenAbility nenSum;
-
-    // DSU:
-    Squad* parent;
-    int fightOffsetToParent;
-    NenAbility nenOffsetToParent;
+    int setSize;     // only meaningful at DSU root: number of DSU nodes in this set
 
-    // only meaningful at DSU root:
-    int fightsAddRoot;
+    bool alive;      // false means the squad (and all its hunters) are "dead"
+    bool freed;      // slot on SquadStore's free list
 
-    explicit Squad(int squadId)
-        : id(squadId),
-          alive(true),
+    Squad(int squadId, SquadIndex self)
+        : nenSum(NenPacked::of(NenVec::zero())),
+          auraSum(0),
+          lastHunter(NO_HUNTER),
+          nextInSet(self),
+          id(squadId),
+          index(-1),
           experience(0),
           huntersCount(0),
-          auraSum(0),
-          nenSum(NenAbility::zero()),
-          parent(nullptr),
-          fightOffsetToParent(0),
-          nenOffsetToParent(NenAbility::zero()),
-          fightsAddRoot(0)
+          setSize(1),
+          alive(true),
+          freed(false)
     {}
 
     int effectiveNen() const {
-        return nenSum.getEffectiveNenAbility();
+        return nenSum.unpack().effective();
     }
 };
 
+static_assert(sizeof(Squad) <= 64, "Squad must fit one cache line");
+
 #endif // DS_WET2_WINTER_2026_01_SQUAD_H
@@ -0,0 +1,153 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_SQUADSTORE_H
+#define DS_WET2_WINTER_2026_01_SQUADSTORE_H
+
+#include <cstdint>     // uintptr_t
+#include <new>         // placement new, std::bad_alloc
+
+#include "Squad.h"
+
+// All squads ever created, addressed by a dense SquadIndex:
+// - DsuNode records (hot) in one flat array, so a find walk only touches
+//   32-byte nodes, two per cache line, with no page or pointer hop between
+//   them. The array grows by doubling (aligned to 32 by hand, C++14
+//   ::operator new only guarantees alignof(std::max_align_t)).
+// - Squad records (cold) in pages of PAGE_SIZE that never move.
+// destroy() puts an index on a free list threaded through the DsuNode
+// parent links and marks the Squad record freed; create() reuses it first.
+// forEach() visits the live squads in index order (creation order while
+// nothing was destroyed); f may destroy any squad, visited or not.
+// A failed growth throws std::bad_alloc before anything changes.
+// No STL containers.
+
+class SquadStore {
+private:
+    static const int PAGE_SHIFT = 10;
+    static const SquadIndex PAGE_SIZE = 1u << PAGE_SHIFT;
+    static const SquadIndex PAGE_MASK = PAGE_SIZE - 1;
+    static const SquadIndex FIRST_NODES = 256;
+
+    DsuNode* nodes;
+    void* nodesRaw;          // block returned by ::operator new (nodes is aligned inside it)
+    SquadIndex nodeCap;
+
+    Squad** pages;           // page table
+    SquadIndex pageCount;
+    SquadIndex pageCap;
+
+    SquadIndex used;         // indices handed out so far
+    SquadIndex freeHead;
+    int live;
+
+private:
+    void growNodes(SquadIndex newCap) {
+        void* raw = ::operator new(sizeof(DsuNode) * (size_t)newCap + alignof(DsuNode) - 1);
+        uintptr_t addr = reinterpret_cast<uintptr_t>(raw);
+        addr = (addr + alignof(DsuNode) - 1) & ~(uintptr_t)(alignof(DsuNode) - 1);
+        DsuNode* fresh = reinterpret_cast<DsuNode*>(addr);
+        for (SquadIndex i = 0; i < used; i++) fresh[i] = nodes[i];
+        ::operator delete(nodesRaw);
+        nodesRaw = raw;
+        nodes = fresh;
+        nodeCap = newCap;
+    }
+
+    void addPage() {
+        if (pageCount == pageCap) {
+            SquadIndex newCap = pageCap ? pageCap * 2 : 8;
+            Squad** bigger = new Squad*[newCap];
+            for (SquadIndex i = 0; i < pageCount; i++) bigger[i] = pages[i];
+            delete[] pages;
+            pages = bigger;
+            pageCap = newCap;
+        }
+        pages[pageCount] = static_cast<Squad*>(::operator new(sizeof(Squad) * (size_t)PAGE_SIZE));
+        pageCount += 1;
+    }
+
+    // room for the fresh index `used`
+    void makeRoom() {
+        if (used == NO_SQUAD - 1) throw std::bad_alloc();
+        if (used == nodeCap) growNodes(nodeCap ? nodeCap * 2 : FIRST_NODES);
+        if ((used >> PAGE_SHIFT) == pageCount) addPage();
+    }
+
+public:
+    SquadStore()
+        : nodes(nullptr), nodesRaw(nullptr), nodeCap(0),
+          pages(nullptr), pageCount(0), pageCap(0),
+          used(0), freeHead(NO_SQUAD), live(0) {}
+    ~SquadStore() { releaseAll(); }
+
+    SquadStore(const SquadStore&) = delete;
+    SquadStore& operator=(const SquadStore&) = delete;
+
+    int size() const { return live; }
+
+    // room for n live squads without further allocation
+    void reserve(long long n) {
+        if (n >= (long long)NO_SQUAD) throw std::bad_alloc();
+        if (n > (long long)nodeCap) growNodes((SquadIndex)n);
+        while ((long long)pageCount * PAGE_SIZE < n) addPage();
+    }
+
+    // a fresh DSU root (no parent, no lazy terms) with its Squad record
+    SquadIndex create(int squadId) {
+        SquadIndex s;
+        if (freeHead != NO_SQUAD) {
+            s = freeHead;
+            freeHead = nodes[s].parent;
+        } else {
+            makeRoom();
+            s = used++;
+        }
+        DsuNode& n = nodes[s];
+        n.parent = NO_SQUAD;
+        n.fightOffset = 0;
+        n.nenOffset = NenPacked::of(NenVec::zero());
+        new (&at(s)) Squad(squadId, s);
+        live += 1;
+        return s;
+    }
+
+    // s (created here, still live) is dropped; its index is reused
+    void destroy(SquadIndex s) {
+        at(s).freed = true;
+        nodes[s].parent = freeHead;
+        freeHead = s;
+        live -= 1;
+    }
+
+    template <typename F>
+    void forEach(F f) const {
+        for (SquadIndex s = 0; s < used; s++) {
+            if (!at(s).freed) f(s);
+        }
+    }
+
+    void releaseAll() {
+        for (SquadIndex i = 0; i < pageCount; i++) ::operator delete(pages[i]);
+        delete[] pages;
+        ::operator delete(nodesRaw);
+        nodes = nullptr;
+        nodesRaw = nullptr;
+        nodeCap = 0;
+        pages = nullptr;
+        pageCount = 0;
+        pageCap = 0;
+        used = 0;
+        freeHead = NO_SQUAD;
+        live = 0;
+    }
+
+    DsuNode& node(SquadIndex s) { return nodes[s]; }
+    const DsuNode& node(SquadIndex s) const { return nodes[s]; }
+
+    Squad& at(SquadIndex s) { return pages[s >> PAGE_SHIFT][s & PAGE_MASK]; }
+    const Squad& at(SquadIndex s) const { return pages[s >> PAGE_SHIFT][s & PAGE_MASK]; }
+};
+
+#endif // DS_WET2_WINTER_2026_01_SQUADSTORE_H
@@ -0,0 +1,55 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_SQUADTRANSFER_H
+#define DS_WET2_WINTER_2026_01_SQUADTRANSFER_H
+
+#include "NenVec.h"
+
+// Plain records exchanged between Huntech instances by the sharded front
+// end (tools/ShardedHuntech.h).
+
+// What squad_duel reads from one side.
+struct SquadDuelSide {
+    NenVec nenSum;
+    long long auraSum;
+    int experience;
+    int huntersCount;
+};
+
+// One hunter of a migrating squad, in absolute terms: fights is the current
+// fight count and prefix the Nen sum of the hunters before it in the squad,
+// so partial Nen ability = prefix + ability.
+struct TransferHunter {
+    int id;
+    int aura;
+    int fights;
+    int ability[6];
+    int prefix[6];
+};
+
+// An active squad with its whole DSU set (export_squad -> import_squad).
+class SquadTransfer {
+public:
+    int squadId;
+    int experience;
+    int hunterCount;
+    TransferHunter* hunters;
+
+    SquadTransfer() : squadId(0), experience(0), hunterCount(0), hunters(nullptr) {}
+    ~SquadTransfer() { delete[] hunters; }
+
+    SquadTransfer(const SquadTransfer&) = delete;
+    SquadTransfer& operator=(const SquadTransfer&) = delete;
+
+    // room for n hunters, previous content dropped
+    void reset(int n) {
+        TransferHunter* fresh = new TransferHunter[n > 0 ? n : 1];
+        delete[] hunters;
+        hunters = fresh;
+        hunterCount = n;
+    }
+};
+
+#endif // DS_WET2_WINTER_2026_01_SQUADTRANSFER_H
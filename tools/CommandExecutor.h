@@ -0,0 +1,91 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_COMMANDEXECUTOR_H
+#define DS_WET2_WINTER_2026_01_COMMANDEXECUTOR_H
+
+#include "../Huntech26a2.h"
+#include "CommandParser.h"
+
+// Runs one decoded Command against Huntech and keeps the answer in a plain
+// Result record, so parsing, execution and formatting stay separate stages.
+
+enum ResultKind : unsigned char {
+    RESULT_STATUS = 0,   // "<op>: <status>"
+    RESULT_INT,          // "<op>: <status>[, <int>]"
+    RESULT_NEN           // "<op>: <status>[, <NenAbility>]"
+};
+
+struct Result {
+    Op op;
+    ResultKind kind;
+    StatusType status;
+    int value;
+    NenAbility nen;
+};
+
+inline void setResult(Result& r, StatusType st) {
+    r.kind = RESULT_STATUS;
+    r.status = st;
+}
+
+inline void setResult(Result& r, output_t<int> res) {
+    r.kind = RESULT_INT;
+    r.status = res.status();
+    if (r.status == StatusType::SUCCESS) r.value = res.ans();
+}
+
+inline void setResult(Result& r, output_t<NenAbility> res) {
+    r.kind = RESULT_NEN;
+    r.status = res.status();
+    if (r.status == StatusType::SUCCESS) r.nen = res.ans();
+}
+
+inline void execute(Huntech& ht, const Command& c, Result& r) {
+    r.op = c.op;
+    switch (c.op) {
+        case Op::ADD_SQUAD:
+            setResult(r, ht.add_squad(c.arg[0]));
+            break;
+        case Op::REMOVE_SQUAD:
+            setResult(r, ht.remove_squad(c.arg[0]));
+            break;
+        case Op::ADD_HUNTER:
+            setResult(r, ht.add_hunter(c.arg[0], c.arg[1], nenOfType(c.nen), c.arg[2], c.arg[3]));
+            break;
+        case Op::SQUAD_DUEL:
+            setResult(r, ht.squad_duel(c.arg[0], c.arg[1]));
+            break;
+        case Op::GET_HUNTER_FIGHTS:
+            setResult(r, ht.get_hunter_fights_number(c.arg[0]));
+            break;
+        case Op::GET_SQUAD_EXPERIENCE:
+            setResult(r, ht.get_squad_experience(c.arg[0]));
+            break;
+        case Op::GET_ITH_AURA_SQUAD:
+            setResult(r, ht.get_ith_collective_aura_squad(c.arg[0]));
+            break;
+        case Op::GET_PARTIAL_NEN:
+            setResult(r, ht.get_partial_nen_ability(c.arg[0]));
+            break;
+        case Op::FORCE_JOIN:
+            setResult(r, ht.force_join(c.arg[0], c.arg[1]));
+            break;
+        default:
+            setResult(r, StatusType::INVALID_INPUT);
+            break;
+    }
+}
+
+inline const char* statusName(StatusType st) {
+    static const char* names[] = {
+        "SUCCESS",
+        "ALLOCATION_ERROR",
+        "INVALID_INPUT",
+        "FAILURE"
+    };
+    return names[(int)st];
+}
+
+#endif // DS_WET2_WINTER_2026_01_COMMANDEXECUTOR_H
@@ -0,0 +1,177 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_COMMANDLOG_H
+#define DS_WET2_WINTER_2026_01_COMMANDLOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CommandParser.h"
+
+// Binary command log: a fixed header followed by fixed-width records.
+//
+//   header : magic "HTCMDLOG" | u32 version | u32 record size | u64 record count
+//   record : u8 op | u8 nen | u16 reserved (0) | i32 arg[4]
+//
+// All fields are little-endian (the native order of the machines we run on).
+// Unused args are 0. A record maps 1:1 onto a Command, so replay needs no
+// parsing at all.
+
+struct LogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t count;
+};
+
+struct LogRecord {
+    uint8_t op;
+    uint8_t nen;
+    uint16_t reserved;
+    int32_t arg[4];
+};
+
+static const char LOG_MAGIC[8] = { 'H', 'T', 'C', 'M', 'D', 'L', 'O', 'G' };
+static const uint32_t LOG_VERSION = 1;
+
+static_assert(sizeof(LogHeader) == 24, "LogHeader layout");
+static_assert(sizeof(LogRecord) == 20, "LogRecord layout");
+
+inline void toRecord(const Command& c, LogRecord& r) {
+    r.op = (uint8_t)c.op;
+    r.nen = (c.op == Op::ADD_HUNTER) ? c.nen : 0;
+    r.reserved = 0;
+    int argc = (c.op == Op::ADD_HUNTER) ? 4
+             : (c.op == Op::SQUAD_DUEL || c.op == Op::FORCE_JOIN) ? 2 : 1;
+    for (int i = 0; i < 4; i++) r.arg[i] = (i < argc) ? c.arg[i] : 0;
+}
+
+inline void fromRecord(const LogRecord& r, Command& c) {
+    c.op = (Op)r.op;
+    c.nen = r.nen;
+    for (int i = 0; i < 4; i++) c.arg[i] = r.arg[i];
+}
+
+// Buffered appender. The record count in the header is patched on close().
+class CommandLogWriter {
+private:
+    static const int BATCH = 1 << 14;
+
+    FILE* f;
+    LogRecord* pending;
+    int used;
+    uint64_t total;
+
+    bool drain() {
+        if (used > 0 && fwrite(pending, sizeof(LogRecord), (size_t)used, f) != (size_t)used) return false;
+        used = 0;
+        return true;
+    }
+
+public:
+    CommandLogWriter() : f(nullptr), pending(new LogRecord[BATCH]), used(0), total(0) {}
+    ~CommandLogWriter() {
+        close();
+        delete[] pending;
+    }
+
+    CommandLogWriter(const CommandLogWriter&) = delete;
+    CommandLogWriter& operator=(const CommandLogWriter&) = delete;
+
+    bool open(const char* path) {
+        f = fopen(path, "wb");
+        if (!f) return false;
+
+        LogHeader h;
+        memcpy(h.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+        h.version = LOG_VERSION;
+        h.recordSize = (uint32_t)sizeof(LogRecord);
+        h.count = 0;
+        return fwrite(&h, sizeof(h), 1, f) == 1;
+    }
+
+    bool isOpen() const { return f != nullptr; }
+    uint64_t count() const { return total; }
+
+    bool append(const Command& c) {
+        toRecord(c, pending[used]);
+        used += 1;
+        total += 1;
+        return used < BATCH || drain();
+    }
+
+    bool close() {
+        if (!f) return true;
+        bool ok = drain();
+        ok = ok && fseek(f, (long)offsetof(LogHeader, count), SEEK_SET) == 0;
+        ok = ok && fwrite(&total, sizeof(total), 1, f) == 1;
+        ok = (fclose(f) == 0) && ok;
+        f = nullptr;
+        return ok;
+    }
+};
+
+// Read-only mapping of a whole log file.
+class CommandLogReader {
+private:
+    void* base;
+    size_t len;
+    const LogRecord* recs;
+    uint64_t n;
+
+public:
+    CommandLogReader() : base(nullptr), len(0), recs(nullptr), n(0) {}
+    ~CommandLogReader() {
+        if (base) munmap(base, len);
+    }
+
+    CommandLogReader(const CommandLogReader&) = delete;
+    CommandLogReader& operator=(const CommandLogReader&) = delete;
+
+    // Returns nullptr on success, otherwise a short error message.
+    const char* open(const char* path) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return "cannot open file";
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(LogHeader)) {
+            ::close(fd);
+            return "file too short";
+        }
+        len = (size_t)st.st_size;
+        base = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            base = nullptr;
+            return "mmap failed";
+        }
+
+        const LogHeader* h = (const LogHeader*)base;
+        if (memcmp(h->magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0) return "bad magic";
+        if (h->version != LOG_VERSION) return "unsupported version";
+        if (h->recordSize != sizeof(LogRecord)) return "unexpected record size";
+        if (h->count > (len - sizeof(LogHeader)) / sizeof(LogRecord)) return "truncated log";
+
+        madvise(base, len, MADV_SEQUENTIAL);
+        recs = (const LogRecord*)((const char*)base + sizeof(LogHeader));
+        n = h->count;
+        for (uint64_t i = 0; i < n; i++) {
+            if (recs[i].op >= (uint8_t)Op::COUNT || recs[i].nen > NEN_INVALID) return "corrupt record";
+        }
+        return nullptr;
+    }
+
+    uint64_t count() const { return n; }
+    const LogRecord& at(uint64_t i) const { return recs[i]; }
+};
+
+#endif // DS_WET2_WINTER_2026_01_COMMANDLOG_H
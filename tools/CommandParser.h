@@ -0,0 +1,321 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_COMMANDPARSER_H
+#define DS_WET2_WINTER_2026_01_COMMANDPARSER_H
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../wet2util.h"
+
+// Zero-copy front end for the Huntech command language (same language as
+// main26a2.cpp). The whole input is mapped (or read in large blocks) into one
+// contiguous range, tokens are slices of that range, ops are dispatched by a
+// switch on token length + first letter, and Nen type names are decoded
+// without building a std::string.
+
+enum class Op : unsigned char {
+    ADD_SQUAD = 0,
+    REMOVE_SQUAD,
+    ADD_HUNTER,
+    SQUAD_DUEL,
+    GET_HUNTER_FIGHTS,
+    GET_SQUAD_EXPERIENCE,
+    GET_ITH_AURA_SQUAD,
+    GET_PARTIAL_NEN,
+    FORCE_JOIN,
+    COUNT
+};
+
+static const int OP_COUNT = (int)Op::COUNT;
+
+inline const char* opName(Op op) {
+    static const char* names[OP_COUNT] = {
+        "addSquad",
+        "removeSquad",
+        "addHunter",
+        "squadDuel",
+        "getHunterFightsNumber",
+        "getSquadExperience",
+        "getIthCollectiveAuraSquad",
+        "getPartialNenAbility",
+        "forceJoin"
+    };
+    return names[(int)op];
+}
+
+// Nen type index as used by NenAbility (0 = Enhancer ... 5 = Specialist),
+// NEN_INVALID for any other word.
+static const unsigned char NEN_INVALID = 6;
+
+inline const char* nenName(unsigned char nen) {
+    static const char* names[6] = {
+        "Enhancer", "Emitter", "Transmuter", "Conjurer", "Manipulator", "Specialist"
+    };
+    return names[nen];
+}
+
+// Single-type NenAbility values, built once (the only string construction).
+inline const NenAbility& nenOfType(unsigned char nen) {
+    static const NenAbility table[7] = {
+        NenAbility(std::string("Enhancer")),
+        NenAbility(std::string("Emitter")),
+        NenAbility(std::string("Transmuter")),
+        NenAbility(std::string("Conjurer")),
+        NenAbility(std::string("Manipulator")),
+        NenAbility(std::string("Specialist")),
+        NenAbility::invalid()
+    };
+    return table[nen];
+}
+
+struct Command {
+    Op op;
+    unsigned char nen;   // addHunter only
+    int arg[4];          // API arguments in call order
+};
+
+struct Token {
+    const char* p;
+    int n;
+
+    bool is(const char* lit, int len) const {
+        return n == len && memcmp(p, lit, (size_t)len) == 0;
+    }
+};
+
+// Whole input as one read-only range: mmap for regular files,
+// otherwise read() in large blocks into a growing buffer.
+class InputBuffer {
+private:
+    static const size_t READ_BLOCK = (size_t)1 << 20;
+
+    const char* data;
+    size_t len;
+    void* mapped;
+    char* owned;
+
+public:
+    InputBuffer() : data(nullptr), len(0), mapped(nullptr), owned(nullptr) {}
+    ~InputBuffer() {
+        if (mapped) munmap(mapped, len);
+        free(owned);
+    }
+
+    InputBuffer(const InputBuffer&) = delete;
+    InputBuffer& operator=(const InputBuffer&) = delete;
+
+    const char* begin() const { return data; }
+    const char* end() const { return data + len; }
+
+    bool load(int fd) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* m = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) {
+                madvise(m, (size_t)st.st_size, MADV_SEQUENTIAL);
+                mapped = m;
+                data = (const char*)m;
+                len = (size_t)st.st_size;
+                return true;
+            }
+        }
+
+        size_t cap = 0;
+        while (true) {
+            if (cap - len < READ_BLOCK) {
+                size_t newCap = cap ? cap * 2 : READ_BLOCK * 4;
+                char* bigger = (char*)realloc(owned, newCap);
+                if (!bigger) return false;
+                owned = bigger;
+                cap = newCap;
+            }
+            ssize_t got = read(fd, owned + len, cap - len);
+            if (got < 0) return false;
+            if (got == 0) break;
+            len += (size_t)got;
+        }
+        data = owned;
+        return true;
+    }
+};
+
+// Tokenizer + command decoder. Mirrors the stream semantics of the reference
+// driver: arguments live in persistent d1..d4 / nen slots, an integer read
+// stops at the first non-digit (the remainder is the next token), the first
+// failed integer reads as 0 (or is clamped on overflow) and later reads of
+// the same command leave their slots untouched.
+class CommandParser {
+public:
+    enum Status {
+        OK,           // cmd is complete
+        END,          // clean end of input
+        UNKNOWN_OP,   // token holds the unknown op
+        BAD_FORMAT    // cmd should still be executed, then stop
+    };
+
+private:
+    const char* cur;
+    const char* last;
+    bool failed;
+
+    int d1, d2, d3, d4;
+    unsigned char nen;
+
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    bool nextToken(Token& t) {
+        while (cur < last && isSpace(*cur)) cur++;
+        if (cur == last) return false;
+        t.p = cur;
+        while (cur < last && !isSpace(*cur)) cur++;
+        t.n = (int)(cur - t.p);
+        return true;
+    }
+
+    // Like `cin >> int`: optional sign and the longest run of digits; the
+    // rest of the word stays in the input and starts the next token
+    // ("12abc" reads 12, then "abc").
+    void readInt(int& out) {
+        if (failed) return;
+
+        while (cur < last && isSpace(*cur)) cur++;
+        bool neg = false;
+        if (cur < last && (*cur == '-' || *cur == '+')) {
+            neg = (*cur == '-');
+            cur++;
+        }
+        if (cur == last || (unsigned)(*cur - '0') > 9) {
+            out = 0;
+            failed = true;
+            return;
+        }
+
+        long long v = 0;
+        bool overflow = false;
+        for (; cur < last; cur++) {
+            unsigned d = (unsigned)(*cur - '0');
+            if (d > 9) break;
+            if (!overflow) {
+                v = v * 10 + d;
+                if (v > (long long)INT_MAX + 1) overflow = true;
+            }
+        }
+        if (neg) v = -v;
+        if (overflow || v > INT_MAX || v < INT_MIN) {
+            out = neg ? INT_MIN : INT_MAX;
+            failed = true;
+            return;
+        }
+        out = (int)v;
+    }
+
+    void readNen() {
+        if (failed) return;
+
+        Token t;
+        if (!nextToken(t)) {
+            failed = true;
+            return;
+        }
+        nen = parseNen(t);
+    }
+
+public:
+    CommandParser(const char* begin, const char* end)
+        : cur(begin), last(end), failed(false),
+          d1(0), d2(0), d3(0), d4(0), nen(NEN_INVALID) {}
+
+    static bool parseOp(const Token& t, Op& op) {
+        if (t.n == 0) return false;
+        switch (t.n) {
+            case 8:
+                op = Op::ADD_SQUAD;
+                return t.is("addSquad", 8);
+            case 9:
+                switch (t.p[0]) {
+                    case 'a': op = Op::ADD_HUNTER; return t.is("addHunter", 9);
+                    case 's': op = Op::SQUAD_DUEL; return t.is("squadDuel", 9);
+                    case 'f': op = Op::FORCE_JOIN; return t.is("forceJoin", 9);
+                    default:  return false;
+                }
+            case 11:
+                op = Op::REMOVE_SQUAD;
+                return t.is("removeSquad", 11);
+            case 18:
+                op = Op::GET_SQUAD_EXPERIENCE;
+                return t.is("getSquadExperience", 18);
+            case 20:
+                op = Op::GET_PARTIAL_NEN;
+                return t.is("getPartialNenAbility", 20);
+            case 21:
+                op = Op::GET_HUNTER_FIGHTS;
+                return t.is("getHunterFightsNumber", 21);
+            case 25:
+                op = Op::GET_ITH_AURA_SQUAD;
+                return t.is("getIthCollectiveAuraSquad", 25);
+            default:
+                return false;
+        }
+    }
+
+    static unsigned char parseNen(const Token& t) {
+        if (t.n == 0) return NEN_INVALID;
+        switch (t.p[0]) {
+            case 'E':
+                if (t.is("Enhancer", 8)) return 0;
+                if (t.is("Emitter", 7)) return 1;
+                return NEN_INVALID;
+            case 'T': return t.is("Transmuter", 10) ? 2 : NEN_INVALID;
+            case 'C': return t.is("Conjurer", 8) ? 3 : NEN_INVALID;
+            case 'M': return t.is("Manipulator", 11) ? 4 : NEN_INVALID;
+            case 'S': return t.is("Specialist", 10) ? 5 : NEN_INVALID;
+            default:  return NEN_INVALID;
+        }
+    }
+
+    // Parses the next command. On UNKNOWN_OP, opToken holds the bad op.
+    Status next(Command& cmd, Token& opToken) {
+        if (failed || !nextToken(opToken)) return END;
+        if (!parseOp(opToken, cmd.op)) return UNKNOWN_OP;
+
+        switch (cmd.op) {
+            case Op::ADD_HUNTER:
+                // addHunter <hunterId> <squadId> <nenTypeString> <aura> <fightsHad>
+                readInt(d1);
+                readInt(d2);
+                readNen();
+                readInt(d3);
+                readInt(d4);
+                cmd.arg[0] = d1;
+                cmd.arg[1] = d2;
+                cmd.arg[2] = d3;
+                cmd.arg[3] = d4;
+                cmd.nen = nen;
+                break;
+            case Op::SQUAD_DUEL:
+            case Op::FORCE_JOIN:
+                readInt(d1);
+                readInt(d2);
+                cmd.arg[0] = d1;
+                cmd.arg[1] = d2;
+                break;
+            default:
+                readInt(d1);
+                cmd.arg[0] = d1;
+                break;
+        }
+        return failed ? BAD_FORMAT : OK;
+    }
+};
+
+#endif // DS_WET2_WINTER_2026_01_COMMANDPARSER_H
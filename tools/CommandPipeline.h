@@ -0,0 +1,96 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_COMMANDPIPELINE_H
+#define DS_WET2_WINTER_2026_01_COMMANDPIPELINE_H
+
+#include <thread>
+
+#include "CommandLog.h"
+#include "OutputBuffer.h"
+#include "SpscRing.h"
+
+// Three-stage replay (huntech_replay --pipeline):
+//
+//   parser thread  --SpscRing<ParsedCommand>-->  executor (calling thread,
+//   owns Huntech)  --SpscRing<ExecutedCommand>-->  formatter thread
+//
+// Tokenizing (and --record) and formatting/writing run on their own threads,
+// so the executor only pops a Command, calls Huntech and pushes a Result.
+// Both rings are FIFO with a single producer and consumer, so the output is
+// byte-identical to the serial loop, including the driver messages that
+// end a run (unknown command, invalid input format).
+
+struct ParsedCommand {
+    Command cmd;
+    CommandParser::Status st;
+    Token opToken;   // points into the input buffer (UNKNOWN_OP message)
+};
+
+struct ExecutedCommand {
+    Result res;
+    CommandParser::Status st;
+    Token opToken;
+};
+
+// Runs the whole input through the pipeline. afterEach() is called on the
+// executor thread after every executed command (stats polling).
+template <typename AfterEach>
+void runPipelined(Huntech& ht, CommandParser& parser, OutputBuffer& out,
+                  CommandLogWriter& recorder, AfterEach afterEach)
+{
+    static const unsigned long long RING = 1 << 12;
+    SpscRing<ParsedCommand> parsed(RING);
+    SpscRing<ExecutedCommand> executed(RING);
+
+    std::thread parserThread([&]() {
+        ParsedCommand p{};
+        while (true) {
+            p.st = parser.next(p.cmd, p.opToken);
+            if ((p.st == CommandParser::OK || p.st == CommandParser::BAD_FORMAT) && recorder.isOpen()) {
+                (void)recorder.append(p.cmd);   // every command that gets executed
+            }
+            parsed.push(p);
+            if (p.st != CommandParser::OK) break;
+        }
+    });
+
+    std::thread formatterThread([&]() {
+        ExecutedCommand e{};
+        while (true) {
+            executed.pop(e);
+            if (e.st == CommandParser::END) break;
+            if (e.st == CommandParser::UNKNOWN_OP) {
+                out.line("Unknown command: ", e.opToken.p, e.opToken.n);
+                break;
+            }
+            out.result(e.res);
+            // Verify no faults
+            if (e.st == CommandParser::BAD_FORMAT) {
+                out.line("Invalid input format", "", 0);
+                break;
+            }
+        }
+        out.flush();
+    });
+
+    ParsedCommand p{};
+    ExecutedCommand e{};
+    while (true) {
+        parsed.pop(p);
+        e.st = p.st;
+        e.opToken = p.opToken;
+        if (p.st == CommandParser::OK || p.st == CommandParser::BAD_FORMAT) {
+            execute(ht, p.cmd, e.res);
+            afterEach();
+        }
+        executed.push(e);
+        if (p.st != CommandParser::OK) break;
+    }
+
+    parserThread.join();
+    formatterThread.join();
+}
+
+#endif // DS_WET2_WINTER_2026_01_COMMANDPIPELINE_H
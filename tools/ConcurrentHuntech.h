@@ -0,0 +1,90 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_CONCURRENTHUNTECH_H
+#define DS_WET2_WINTER_2026_01_CONCURRENTHUNTECH_H
+
+#include "CommandExecutor.h"
+#include "ReadMostlyLock.h"
+
+// Huntech shared by one writer thread and any number of reader threads.
+//
+// The four queries are answered by the const peek_* twins, which walk the
+// DSU without path compression, so readers only hold the lock in shared
+// mode and never write to Huntech. Compression is left to the writer: its
+// own mutations compress the paths they touch, and with compressEvery > 0
+// every compressEvery-th write also runs compress_paths() before releasing
+// the lock, keeping the readers' walks one hop long.
+//
+// Every read also reports `version`, the number of writes completed before
+// it, i.e. the point of the write sequence at which it took effect.
+//
+// The lock is cache-line aligned, which C++14 `new` does not honour: keep a
+// ConcurrentHuntech on the stack or in static storage.
+//
+// Built with -DHUNTECH_STATS the AVL search counters are bumped by readers
+// without synchronization; use the stats build single-threaded.
+
+class ConcurrentHuntech {
+private:
+    Huntech ht;
+    mutable ReadMostlyLock lock;
+    unsigned long long writes;   // guarded by lock
+    int compressEvery;
+    int sinceCompress;
+
+public:
+    explicit ConcurrentHuntech(int compressEveryWrites = 0)
+        : ht(), lock(), writes(0), compressEvery(compressEveryWrites), sinceCompress(0) {}
+
+    ConcurrentHuntech(const ConcurrentHuntech&) = delete;
+    ConcurrentHuntech& operator=(const ConcurrentHuntech&) = delete;
+
+    // Writer thread only. Runs a mutating command (the four queries are
+    // accepted too and run through the regular, compressing API).
+    void write(const Command& c, Result& r) {
+        lock.lock();
+        execute(ht, c, r);
+        writes += 1;
+        if (compressEvery > 0 && ++sinceCompress >= compressEvery) {
+            sinceCompress = 0;
+            ht.compress_paths();
+        }
+        lock.unlock();
+    }
+
+    // Any thread. Answers one of the four queries; other ops are rejected
+    // with INVALID_INPUT.
+    void read(const Command& c, Result& r, unsigned long long* version = nullptr) const {
+        r.op = c.op;
+        lock.lock_shared();
+        const Huntech& h = ht;
+        switch (c.op) {
+            case Op::GET_HUNTER_FIGHTS:
+                setResult(r, h.peek_hunter_fights_number(c.arg[0]));
+                break;
+            case Op::GET_SQUAD_EXPERIENCE:
+                setResult(r, h.peek_squad_experience(c.arg[0]));
+                break;
+            case Op::GET_ITH_AURA_SQUAD:
+                setResult(r, h.peek_ith_collective_aura_squad(c.arg[0]));
+                break;
+            case Op::GET_PARTIAL_NEN:
+                setResult(r, h.peek_partial_nen_ability(c.arg[0]));
+                break;
+            default:
+                setResult(r, StatusType::INVALID_INPUT);
+                break;
+        }
+        if (version) *version = writes;
+        lock.unlock_shared();
+    }
+
+    static bool isQuery(Op op) {
+        return op == Op::GET_HUNTER_FIGHTS || op == Op::GET_SQUAD_EXPERIENCE ||
+               op == Op::GET_ITH_AURA_SQUAD || op == Op::GET_PARTIAL_NEN;
+    }
+};
+
+#endif // DS_WET2_WINTER_2026_01_CONCURRENTHUNTECH_H
@@ -0,0 +1,87 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_LATENCYHISTOGRAM_H
+#define DS_WET2_WINTER_2026_01_LATENCYHISTOGRAM_H
+
+#include <cstdint>
+
+// Log-linear latency histogram (HDR style) with fixed memory:
+// values below 2^SUB_BITS are exact, larger values keep their top
+// SUB_BITS + 1 significant bits (about 3% relative error).
+// Recording is a couple of shifts and one increment, so it can sit on the
+// hot path of a 10^8-operation benchmark.
+
+class LatencyHistogram {
+private:
+    static const int SUB_BITS = 5;
+    static const int SUB_COUNT = 1 << SUB_BITS;
+    static const int BUCKETS = (64 - SUB_BITS) * SUB_COUNT + SUB_COUNT;
+
+    uint64_t counts[BUCKETS];
+    uint64_t total;
+    uint64_t maxValue;
+    long double sum;
+
+    static int msb(uint64_t v) {
+        return 63 - __builtin_clzll(v);
+    }
+
+    static int bucketOf(uint64_t v) {
+        if (v < (uint64_t)SUB_COUNT) return (int)v;
+        int e = msb(v) - SUB_BITS;                          // >= 0
+        int sub = (int)((v >> e) & (uint64_t)(SUB_COUNT - 1));
+        return SUB_COUNT + e * SUB_COUNT + sub;
+    }
+
+    // Upper edge of a bucket (the value reported for a percentile).
+    static uint64_t bucketTop(int b) {
+        if (b < SUB_COUNT) return (uint64_t)b;
+        int e = (b - SUB_COUNT) / SUB_COUNT;
+        int sub = (b - SUB_COUNT) % SUB_COUNT;
+        uint64_t base = ((uint64_t)(SUB_COUNT + sub)) << e;
+        return base + (((uint64_t)1 << e) - 1);
+    }
+
+public:
+    LatencyHistogram() { reset(); }
+
+    void reset() {
+        for (int i = 0; i < BUCKETS; i++) counts[i] = 0;
+        total = 0;
+        maxValue = 0;
+        sum = 0;
+    }
+
+    void record(uint64_t v) {
+        counts[bucketOf(v)] += 1;
+        total += 1;
+        sum += (long double)v;
+        if (v > maxValue) maxValue = v;
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return maxValue; }
+    double mean() const { return total ? (double)(sum / (long double)total) : 0.0; }
+
+    // q in [0, 1]; smallest recorded bucket covering that fraction
+    uint64_t percentile(double q) const {
+        if (total == 0) return 0;
+        uint64_t rank = (uint64_t)(q * (double)total + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > total) rank = total;
+
+        uint64_t seen = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            seen += counts[b];
+            if (seen >= rank) {
+                uint64_t top = bucketTop(b);
+                return top < maxValue ? top : maxValue;
+            }
+        }
+        return maxValue;
+    }
+};
+
+#endif // DS_WET2_WINTER_2026_01_LATENCYHISTOGRAM_H
@@ -0,0 +1,129 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_OUTPUTBUFFER_H
+#define DS_WET2_WINTER_2026_01_OUTPUTBUFFER_H
+
+#include <cstring>
+#include <unistd.h>
+
+#include "../NenCodec.h"
+#include "CommandExecutor.h"
+
+// Allocation-free output stage: result lines are formatted into one large
+// reusable buffer (hand-rolled integer conversion, no ostream) and written
+// with a single write() only when the buffer fills up or at flush().
+// Produces exactly the bytes of the reference driver's print() helpers.
+
+class OutputBuffer {
+private:
+    static const size_t CAPACITY = (size_t)1 << 20;
+    static const size_t MAX_LINE = 256;   // longest possible result line
+
+    int fd;
+    char* buf;
+    size_t len;
+
+    void writeAll(const char* p, size_t n) {
+        size_t off = 0;
+        while (off < n) {
+            ssize_t w = write(fd, p + off, n - off);
+            if (w <= 0) break;
+            off += (size_t)w;
+        }
+    }
+
+    void ensure(size_t n) {
+        if (len + n > CAPACITY) flush();
+    }
+
+    void put(const char* s, size_t n) {
+        memcpy(buf + len, s, n);
+        len += n;
+    }
+
+    void putStr(const char* s) { put(s, strlen(s)); }
+
+    void putInt(int v) {
+        char tmp[12];
+        int n = 0;
+        // work on the negative range so INT_MIN needs no special case
+        bool neg = v < 0;
+        int x = neg ? v : -v;
+        do {
+            tmp[n++] = (char)('0' - (x % 10));
+            x /= 10;
+        } while (x != 0);
+        if (neg) buf[len++] = '-';
+        while (n > 0) buf[len++] = tmp[--n];
+    }
+
+    void putNen(const NenAbility& a) {
+        if (!a.isValid()) {
+            putStr("Invalid NenAbility");
+            return;
+        }
+        int counts[6];
+        NenCodec::instance().split(a, counts);
+        for (int i = 0; i < 6; i++) {
+            if (i > 0) put(", ", 2);
+            putStr(nenName((unsigned char)i));
+            buf[len++] = ':';
+            putInt(counts[i]);
+        }
+    }
+
+public:
+    explicit OutputBuffer(int outFd)
+        : fd(outFd), buf(new char[CAPACITY]), len(0) {}
+
+    ~OutputBuffer() {
+        flush();
+        delete[] buf;
+    }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    void flush() {
+        writeAll(buf, len);
+        len = 0;
+    }
+
+    // "<op>: <status>[, <answer>]\n"
+    void result(const Result& r) {
+        ensure(MAX_LINE);
+        putStr(opName(r.op));
+        put(": ", 2);
+        putStr(statusName(r.status));
+        if (r.status == StatusType::SUCCESS) {
+            if (r.kind == RESULT_INT) {
+                put(", ", 2);
+                putInt(r.value);
+            } else if (r.kind == RESULT_NEN) {
+                put(", ", 2);
+                putNen(r.nen);
+            }
+        }
+        buf[len++] = '\n';
+    }
+
+    // "<prefix><s>\n" for driver messages (s may be an arbitrarily long token)
+    void line(const char* prefix, const char* s, int n) {
+        size_t pl = strlen(prefix);
+        ensure(pl + (size_t)n + 1);
+        if (pl + (size_t)n + 1 > CAPACITY) {
+            // does not fit at all: write through
+            writeAll(prefix, pl);
+            writeAll(s, (size_t)n);
+            writeAll("\n", 1);
+            return;
+        }
+        put(prefix, pl);
+        put(s, (size_t)n);
+        buf[len++] = '\n';
+    }
+};
+
+#endif // DS_WET2_WINTER_2026_01_OUTPUTBUFFER_H
@@ -0,0 +1,90 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_READMOSTLYLOCK_H
+#define DS_WET2_WINTER_2026_01_READMOSTLYLOCK_H
+
+#include <atomic>
+#include <thread>
+
+// Reader-writer spin lock for a read-mostly workload with one writer.
+//
+// Readers never touch a shared counter: each reader thread is assigned one
+// of SLOTS cache-line sized counters (round-robin, on first use), so
+// lock_shared()/unlock_shared() of different threads do not bounce a cache
+// line between cores and read throughput scales with the number of cores.
+// The writer raises `writer` and then waits for every slot to drain; a
+// reader that sees the flag backs off, so a waiting writer is never starved.
+//
+// Both sides use the Dekker pattern (reader: bump slot, then check flag;
+// writer: raise flag, then check slots) with seq_cst operations, so at
+// least one of them always sees the other.
+
+class ReadMostlyLock {
+private:
+    static const int SLOTS = 64;
+    static const int CACHE_LINE = 64;
+
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<int> readers;
+    };
+
+    Slot slots[SLOTS];
+    alignas(CACHE_LINE) std::atomic<bool> writer;
+
+    static int mySlot() {
+        static std::atomic<int> nextSlot(0);
+        thread_local int slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % SLOTS;
+        return slot;
+    }
+
+    static void pause(int& spins) {
+        if (++spins < 64) return;
+        spins = 0;
+        std::this_thread::yield();
+    }
+
+public:
+    ReadMostlyLock() : writer(false) {
+        for (int i = 0; i < SLOTS; i++) slots[i].readers.store(0, std::memory_order_relaxed);
+    }
+
+    ReadMostlyLock(const ReadMostlyLock&) = delete;
+    ReadMostlyLock& operator=(const ReadMostlyLock&) = delete;
+
+    void lock_shared() {
+        Slot& s = slots[mySlot()];
+        int spins = 0;
+        while (true) {
+            s.readers.fetch_add(1, std::memory_order_seq_cst);
+            if (!writer.load(std::memory_order_seq_cst)) return;
+
+            // a writer is in or waiting: step aside until it is done
+            s.readers.fetch_sub(1, std::memory_order_release);
+            while (writer.load(std::memory_order_relaxed)) pause(spins);
+        }
+    }
+
+    void unlock_shared() {
+        slots[mySlot()].readers.fetch_sub(1, std::memory_order_release);
+    }
+
+    void lock() {
+        int spins = 0;
+        bool expected = false;
+        while (!writer.compare_exchange_weak(expected, true, std::memory_order_seq_cst)) {
+            expected = false;
+            pause(spins);
+        }
+        for (int i = 0; i < SLOTS; i++) {
+            while (slots[i].readers.load(std::memory_order_seq_cst) != 0) pause(spins);
+        }
+    }
+
+    void unlock() {
+        writer.store(false, std::memory_order_release);
+    }
+};
+
+#endif // DS_WET2_WINTER_2026_01_READMOSTLYLOCK_H
@@ -0,0 +1,442 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_SHARDEDHUNTECH_H
+#define DS_WET2_WINTER_2026_01_SHARDEDHUNTECH_H
+
+#include <atomic>
+#include <climits>
+#include <thread>
+
+#include "CommandPipeline.h"
+
+// Squad-sharded replay (huntech_replay --shards N).
+//
+// N worker threads each own one Huntech and drain an SPSC inbox. The calling
+// thread parses and dispatches; a formatter thread prints the results in
+// command order from a window of result slots, so the output is
+// byte-identical to the serial driver.
+//
+// Ownership directory (dispatcher only): squadHome maps every active squad
+// id to the shard holding its set, hunterHome every hunter id to the shard
+// holding the hunter. A new squad goes to shard id % N; a hunter follows its
+// squad. Commands whose objects live on one shard are queued there and the
+// dispatcher moves on; the directories stay exact without waiting because
+// add_squad/remove_squad/add_hunter outcomes follow from the directory
+// (plus the add_hunter input check). Anything else is coordinated on the
+// dispatcher thread after draining the shards involved (workers are idle
+// then, so the dispatcher may call their Huntech directly):
+//   force_join (same shard)  wait for the answer, drop the forced id on SUCCESS
+//   squad_duel (two shards)  read both sides (get_duel_side), decide with
+//                            Huntech::duel_outcome, apply to each side
+//   force_join (two shards)  check force_join's rules on both sides
+//                            (get_duel_side); if the join will succeed,
+//                            migrate the smaller set to the other shard
+//                            (export_squad/import_squad, directory updated),
+//                            then a local force_join
+//   get_ith                  k-way rank search over all aura trees: take the
+//                            middle key of the widest candidate range, rank
+//                            it on every shard (count_squads_before), narrow
+//                            all ranges; O(N log n) probes of O(N log n)
+// Workloads whose duels and joins stay within a shard run the shards in
+// parallel; every cross-shard command is a barrier for two shards and
+// get_ith for all of them.
+//
+// Built with -DHUNTECH_STATS the counters are shared by the workers without
+// synchronization; use the stats build with the serial driver.
+
+class ShardedHuntech {
+private:
+    static const unsigned long long WINDOW = 1 << 12;   // commands between dispatch and output
+    static const unsigned long long INBOX = 1 << 10;
+    static const int SPINS_BEFORE_YIELD = 128;
+
+    struct Task {
+        Command cmd;
+        unsigned long long seq;
+        bool stop;
+    };
+
+    struct OutSlot {
+        ExecutedCommand e;
+        std::atomic<unsigned long long> ready;   // seq + 1 once e is final
+    };
+
+    struct Shard {
+        Huntech ht;
+        SpscRing<Task> inbox;
+        std::atomic<unsigned long long> done;    // tasks finished (worker)
+        unsigned long long submitted;            // tasks queued (dispatcher)
+        std::thread worker;
+
+        Shard() : ht(), inbox(INBOX), done(0), submitted(0) {}
+    };
+
+    int n;
+    Shard** shards;
+    OutSlot* window;
+    std::atomic<unsigned long long> printed;
+
+    HashTable<int, int> squadHome;
+    HashTable<int, int> hunterHome;
+    SquadTransfer transfer;
+
+    // k-way rank search state, one entry per shard
+    int* lo;
+    int* hi;
+    int* cut;
+
+    static void backOff(int& spins) {
+        if (++spins < SPINS_BEFORE_YIELD) return;
+        spins = 0;
+        std::this_thread::yield();
+    }
+
+    OutSlot& slotOf(unsigned long long seq) { return window[seq & (WINDOW - 1)]; }
+
+    void workerLoop(Shard& s) {
+        Task t;
+        while (true) {
+            s.inbox.pop(t);
+            if (t.stop) return;
+            OutSlot& o = slotOf(t.seq);
+            execute(s.ht, t.cmd, o.e.res);
+            o.ready.store(t.seq + 1, std::memory_order_release);
+            s.done.store(s.done.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+    }
+
+    void formatterLoop(OutputBuffer& out) {
+        for (unsigned long long seq = 0; ; seq++) {
+            OutSlot& o = slotOf(seq);
+            int spins = 0;
+            while (o.ready.load(std::memory_order_acquire) != seq + 1) backOff(spins);
+
+            const ExecutedCommand& e = o.e;
+            if (e.st == CommandParser::END) break;
+            if (e.st == CommandParser::UNKNOWN_OP) {
+                out.line("Unknown command: ", e.opToken.p, e.opToken.n);
+                break;
+            }
+            out.result(e.res);
+            // Verify no faults
+            if (e.st == CommandParser::BAD_FORMAT) {
+                out.line("Invalid input format", "", 0);
+                break;
+            }
+            printed.store(seq + 1, std::memory_order_release);
+        }
+        out.flush();
+    }
+
+    // Dispatcher: the slot for seq, once the formatter is done with its
+    // previous use.
+    OutSlot& claim(unsigned long long seq, CommandParser::Status st, const Token& tok) {
+        int spins = 0;
+        while (seq - printed.load(std::memory_order_acquire) >= WINDOW) backOff(spins);
+        OutSlot& o = slotOf(seq);
+        o.e.st = st;
+        o.e.opToken = tok;
+        return o;
+    }
+
+    void publish(OutSlot& o, unsigned long long seq) {
+        o.ready.store(seq + 1, std::memory_order_release);
+    }
+
+    void submit(int s, const Command& cmd, unsigned long long seq) {
+        Task t;
+        t.cmd = cmd;
+        t.seq = seq;
+        t.stop = false;
+        shards[s]->inbox.push(t);
+        shards[s]->submitted += 1;
+    }
+
+    void drain(int s) {
+        int spins = 0;
+        while (shards[s]->done.load(std::memory_order_acquire) != shards[s]->submitted) backOff(spins);
+    }
+
+    int homeOfNewSquad(int squadId) const { return (int)((unsigned int)squadId % (unsigned int)n); }
+
+    int homeOf(HashTable<int, int>& dir, int id) {
+        const int* s = dir.find(id);
+        return s ? *s : -1;
+    }
+
+    // ---- coordinated commands (run on the dispatcher) ----
+
+    void crossDuel(int a, int sa, int b, int sb, Result& r) {
+        drain(sa);
+        drain(sb);
+        output_t<SquadDuelSide> sideA = shards[sa]->ht.get_duel_side(a);
+        output_t<SquadDuelSide> sideB = shards[sb]->ht.get_duel_side(b);
+        if (sideA.status() != StatusType::SUCCESS) {
+            setResult(r, output_t<int>(sideA.status()));
+            return;
+        }
+        if (sideB.status() != StatusType::SUCCESS) {
+            setResult(r, output_t<int>(sideB.status()));
+            return;
+        }
+        if (sideA.ans().huntersCount == 0 || sideB.ans().huntersCount == 0) {
+            setResult(r, output_t<int>(StatusType::FAILURE));
+            return;
+        }
+        int gainA = 0;
+        int gainB = 0;
+        int res = Huntech::duel_outcome(sideA.ans(), sideB.ans(), gainA, gainB);
+        (void)shards[sa]->ht.apply_duel_result(a, gainA);
+        (void)shards[sb]->ht.apply_duel_result(b, gainB);
+        setResult(r, output_t<int>(res));
+    }
+
+    // moves squad id's set from shard `from` to shard `to`; if the import
+    // fails the set goes back to `from` (fresh there, same answers) and the
+    // directories are left as they are
+    StatusType migrate(int id, int from, int to) {
+        StatusType st = shards[from]->ht.export_squad(id, transfer);
+        if (st != StatusType::SUCCESS) return st;
+        st = shards[to]->ht.import_squad(transfer);
+        if (st != StatusType::SUCCESS) {
+            (void)shards[from]->ht.import_squad(transfer);
+            return st;
+        }
+
+        *squadHome.find(id) = to;
+        for (int k = 0; k < transfer.hunterCount; k++) *hunterHome.find(transfer.hunters[k].id) = to;
+        return StatusType::SUCCESS;
+    }
+
+    // force_join's checks run on the two sides first, so a set is only moved
+    // for a join that will happen
+    void crossJoin(int a, int sa, int b, int sb, Result& r) {
+        drain(sa);
+        drain(sb);
+        output_t<SquadDuelSide> sideA = shards[sa]->ht.get_duel_side(a);
+        output_t<SquadDuelSide> sideB = shards[sb]->ht.get_duel_side(b);
+        if (sideA.status() != StatusType::SUCCESS) {
+            setResult(r, sideA.status());
+            return;
+        }
+        if (sideB.status() != StatusType::SUCCESS) {
+            setResult(r, sideB.status());
+            return;
+        }
+        if (!Huntech::force_join_allowed(sideA.ans(), sideB.ans())) {
+            setResult(r, StatusType::FAILURE);
+            return;
+        }
+
+        // move the set with fewer hunters
+        bool moveA = sideA.ans().huntersCount < sideB.ans().huntersCount;
+        int target = moveA ? sb : sa;
+        StatusType st = moveA ? migrate(a, sa, sb) : migrate(b, sb, sa);
+        if (st == StatusType::SUCCESS) {
+            st = shards[target]->ht.force_join(a, b);
+            if (st == StatusType::SUCCESS) (void)squadHome.erase(b);
+        }
+        setResult(r, st);
+    }
+
+    void sameShardJoin(const Command& cmd, int s, OutSlot& o, unsigned long long seq) {
+        submit(s, cmd, seq);
+        drain(s);
+        if (o.e.res.status == StatusType::SUCCESS) (void)squadHome.erase(cmd.arg[1]);
+    }
+
+    void ithSquad(int i, Result& r) {
+        long long total = 0;
+        for (int s = 0; s < n; s++) {
+            drain(s);
+            lo[s] = 0;
+            hi[s] = shards[s]->ht.count_squads_in_aura_range(LLONG_MIN, LLONG_MAX).ans();
+            total += hi[s];
+        }
+        if (i < 1 || i > total) {
+            setResult(r, output_t<int>(StatusType::FAILURE));
+            return;
+        }
+
+        int need = i;   // rank of the answer among the remaining candidates
+        while (true) {
+            int widest = 0;
+            for (int s = 1; s < n; s++) {
+                if (hi[s] - lo[s] > hi[widest] - lo[widest]) widest = s;
+            }
+            int m = lo[widest] + (hi[widest] - lo[widest]) / 2;
+            Huntech& w = shards[widest]->ht;
+            int id = w.get_ith_collective_aura_squad(m + 1).ans();
+            long long aura = w.get_squad_collective_aura(id).ans();
+
+            int below = 0;
+            for (int s = 0; s < n; s++) {
+                int c = (s == widest) ? m : shards[s]->ht.count_squads_before(aura, id).ans();
+                if (c < lo[s]) c = lo[s];
+                if (c > hi[s]) c = hi[s];
+                cut[s] = c;
+                below += c - lo[s];
+            }
+
+            if (below + 1 == need) {
+                setResult(r, output_t<int>(id));
+                return;
+            }
+            if (below + 1 < need) {
+                need -= below + 1;
+                for (int s = 0; s < n; s++) lo[s] = cut[s];
+                lo[widest] = m + 1;
+            } else {
+                for (int s = 0; s < n; s++) hi[s] = cut[s];
+            }
+        }
+    }
+
+    // Routes one command; either queues it on a shard or completes it here.
+    void dispatch(const Command& cmd, OutSlot& o, unsigned long long seq) {
+        Result& r = o.e.res;
+        r.op = cmd.op;
+        bool inline_ = false;
+
+        switch (cmd.op) {
+            case Op::ADD_SQUAD: {
+                int id = cmd.arg[0];
+                int s = homeOf(squadHome, id);
+                if (s < 0 && id > 0) {
+                    s = homeOfNewSquad(id);
+                    (void)squadHome.insert(id, s);
+                }
+                submit(s < 0 ? 0 : s, cmd, seq);
+                break;
+            }
+            case Op::REMOVE_SQUAD: {
+                int s = homeOf(squadHome, cmd.arg[0]);
+                if (s >= 0) (void)squadHome.erase(cmd.arg[0]);
+                submit(s < 0 ? 0 : s, cmd, seq);
+                break;
+            }
+            case Op::ADD_HUNTER: {
+                bool valid = cmd.arg[0] > 0 && cmd.arg[1] > 0 && nenOfType(cmd.nen).isValid() &&
+                             cmd.arg[2] >= 0 && cmd.arg[3] >= 0;
+                int hs = homeOf(hunterHome, cmd.arg[0]);
+                int ss = homeOf(squadHome, cmd.arg[1]);
+                if (!valid) {
+                    submit(0, cmd, seq);                     // INVALID_INPUT
+                } else if (hs >= 0) {
+                    submit(hs, cmd, seq);                    // FAILURE: id taken there
+                } else if (ss < 0) {
+                    submit(0, cmd, seq);                     // FAILURE: no such squad
+                } else {
+                    (void)hunterHome.insert(cmd.arg[0], ss);
+                    submit(ss, cmd, seq);
+                }
+                break;
+            }
+            case Op::SQUAD_DUEL:
+            case Op::FORCE_JOIN: {
+                int a = cmd.arg[0];
+                int b = cmd.arg[1];
+                int sa = homeOf(squadHome, a);
+                int sb = homeOf(squadHome, b);
+                if (a <= 0 || b <= 0 || a == b || sa < 0 || sb < 0) {
+                    submit(0, cmd, seq);                     // INVALID_INPUT or FAILURE
+                } else if (sa == sb) {
+                    if (cmd.op == Op::FORCE_JOIN) sameShardJoin(cmd, sa, o, seq);
+                    else submit(sa, cmd, seq);
+                } else {
+                    if (cmd.op == Op::FORCE_JOIN) crossJoin(a, sa, b, sb, r);
+                    else crossDuel(a, sa, b, sb, r);
+                    inline_ = true;
+                }
+                break;
+            }
+            case Op::GET_HUNTER_FIGHTS:
+            case Op::GET_PARTIAL_NEN: {
+                int s = homeOf(hunterHome, cmd.arg[0]);
+                submit(s < 0 ? 0 : s, cmd, seq);
+                break;
+            }
+            case Op::GET_SQUAD_EXPERIENCE: {
+                int s = homeOf(squadHome, cmd.arg[0]);
+                submit(s < 0 ? 0 : s, cmd, seq);
+                break;
+            }
+            case Op::GET_ITH_AURA_SQUAD:
+                ithSquad(cmd.arg[0], r);
+                inline_ = true;
+                break;
+            default:
+                submit(0, cmd, seq);
+                break;
+        }
+
+        if (inline_) publish(o, seq);
+    }
+
+public:
+    // reclaim: every shard frees dead and exported sets
+    // (Huntech::enable_reclamation)
+    ShardedHuntech(int shardCount, bool reclaim = false)
+        : n(shardCount < 1 ? 1 : shardCount), shards(nullptr), window(nullptr), printed(0),
+          squadHome(), hunterHome(), transfer(), lo(nullptr), hi(nullptr), cut(nullptr) {
+        shards = new Shard*[n];
+        for (int s = 0; s < n; s++) {
+            shards[s] = new Shard();
+            if (reclaim) shards[s]->ht.enable_reclamation();
+        }
+        window = new OutSlot[WINDOW];
+        for (unsigned long long k = 0; k < WINDOW; k++) window[k].ready.store(0, std::memory_order_relaxed);
+        lo = new int[n];
+        hi = new int[n];
+        cut = new int[n];
+    }
+
+    ~ShardedHuntech() {
+        for (int s = 0; s < n; s++) delete shards[s];
+        delete[] shards;
+        delete[] window;
+        delete[] lo;
+        delete[] hi;
+        delete[] cut;
+    }
+
+    ShardedHuntech(const ShardedHuntech&) = delete;
+    ShardedHuntech& operator=(const ShardedHuntech&) = delete;
+
+    // Runs the whole input; the output matches the serial driver.
+    void run(CommandParser& parser, OutputBuffer& out, CommandLogWriter& recorder) {
+        for (int s = 0; s < n; s++) {
+            Shard* sh = shards[s];
+            sh->worker = std::thread([this, sh]() { workerLoop(*sh); });
+        }
+        std::thread formatter([this, &out]() { formatterLoop(out); });
+
+        Command cmd{};
+        Token tok;
+        for (unsigned long long seq = 0; ; seq++) {
+            CommandParser::Status st = parser.next(cmd, tok);
+            if ((st == CommandParser::OK || st == CommandParser::BAD_FORMAT) && recorder.isOpen()) {
+                (void)recorder.append(cmd);   // every command that gets executed
+            }
+
+            OutSlot& o = claim(seq, st, tok);
+            if (st == CommandParser::END || st == CommandParser::UNKNOWN_OP) {
+                publish(o, seq);
+                break;
+            }
+            dispatch(cmd, o, seq);
+            if (st == CommandParser::BAD_FORMAT) break;
+        }
+
+        Task stop;
+        stop.seq = 0;
+        stop.stop = true;
+        for (int s = 0; s < n; s++) shards[s]->inbox.push(stop);
+        for (int s = 0; s < n; s++) shards[s]->worker.join();
+        formatter.join();
+    }
+};
+
+#endif // DS_WET2_WINTER_2026_01_SHARDEDHUNTECH_H
@@ -0,0 +1,97 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_SPSCRING_H
+#define DS_WET2_WINTER_2026_01_SPSCRING_H
+
+#include <atomic>
+#include <thread>
+
+// Bounded lock-free ring between exactly one producer and one consumer
+// thread (pipeline stages, shard inboxes of huntech_replay).
+//
+// head is written only by the consumer, tail only by the producer, kept on
+// separate cache lines by explicit padding (not alignas, so a ring can be
+// allocated with plain C++14 new). Each side also keeps a private copy of
+// the other's index and re-reads the shared one only when the copy says the
+// ring is full/empty, so in steady state a push or pop touches no shared
+// line except for its own release store. Slots are reused in place (T is
+// assigned, never destroyed per item).
+
+template <typename T>
+class SpscRing {
+private:
+    static const int CACHE_LINE = 64;
+    static const int SPINS_BEFORE_YIELD = 128;
+
+    T* slots;
+    unsigned long long mask;
+
+    char padHead[CACHE_LINE];
+    std::atomic<unsigned long long> head;   // next slot to pop
+    unsigned long long tailCache;           // consumer's copy of tail
+
+    char padTail[CACHE_LINE];
+    std::atomic<unsigned long long> tail;   // next slot to push
+    unsigned long long headCache;           // producer's copy of head
+    char padEnd[CACHE_LINE];
+
+    static void backOff(int& spins) {
+        if (++spins < SPINS_BEFORE_YIELD) return;
+        spins = 0;
+        std::this_thread::yield();
+    }
+
+public:
+    // capacity is rounded up to a power of two
+    explicit SpscRing(unsigned long long capacity)
+        : slots(nullptr), mask(0), head(0), tailCache(0), tail(0), headCache(0) {
+        unsigned long long cap = 2;
+        while (cap < capacity) cap <<= 1;
+        slots = new T[cap];
+        mask = cap - 1;
+    }
+
+    ~SpscRing() { delete[] slots; }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer: false if the ring is full.
+    bool tryPush(const T& item) {
+        unsigned long long t = tail.load(std::memory_order_relaxed);
+        if (t - headCache > mask) {
+            headCache = head.load(std::memory_order_acquire);
+            if (t - headCache > mask) return false;
+        }
+        slots[t & mask] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: false if the ring is empty.
+    bool tryPop(T& item) {
+        unsigned long long h = head.load(std::memory_order_relaxed);
+        if (h == tailCache) {
+            tailCache = tail.load(std::memory_order_acquire);
+            if (h == tailCache) return false;
+        }
+        item = slots[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Blocking variants: spin briefly, then yield the core.
+    void push(const T& item) {
+        int spins = 0;
+        while (!tryPush(item)) backOff(spins);
+    }
+
+    void pop(T& item) {
+        int spins = 0;
+        while (!tryPop(item)) backOff(spins);
+    }
+};
+
+#endif // DS_WET2_WINTER_2026_01_SPSCRING_H
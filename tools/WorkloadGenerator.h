@@ -0,0 +1,241 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+
+#ifndef DS_WET2_WINTER_2026_01_WORKLOADGENERATOR_H
+#define DS_WET2_WINTER_2026_01_WORKLOADGENERATOR_H
+
+#include <cstdint>
+
+#include "../HashTable.h"
+#include "CommandParser.h"
+
+// Parameterized, deterministic Huntech workload.
+//
+// Phase 1 (setup) creates `squads` squads and `huntersPerSquad` hunters in
+// each. Phase 2 emits `ops` mixed commands drawn by weight from the mix.
+// The generator mirrors just enough state (active squad ids, number of
+// hunters) to keep most commands meaningful; the driver reports outcomes
+// back through observe() so squads that were forced away or never created
+// stop being targeted.
+//
+// force_join chains: `chainDepth` consecutive joins reuse the same forcing
+// squad, so the forced sets pile up under one root (deep DSU paths when
+// union is not by size, long offset chains otherwise).
+
+enum class IdDist : unsigned char {
+    DENSE,    // 1, 2, 3, ...
+    SPARSE,   // strided with random gaps, spread over the positive int range
+    RANDOM    // uniform in [1, 2^31 - 1]
+};
+
+struct WorkloadConfig {
+    long long ops;            // mixed phase length
+    int squads;               // initial squads
+    int huntersPerSquad;      // initial hunters per squad
+    int chainDepth;           // consecutive joins with the same forcing squad
+    IdDist ids;
+    uint64_t seed;
+
+    // relative weights of the mixed phase
+    int wDuel;
+    int wJoin;
+    int wQuery;   // split evenly over the four queries
+    int wAdd;     // add_hunter (and add_squad when squads run low)
+    int wRemove;
+
+    WorkloadConfig()
+        : ops(1000000), squads(10000), huntersPerSquad(10), chainDepth(1),
+          ids(IdDist::DENSE), seed(1),
+          wDuel(20), wJoin(5), wQuery(50), wAdd(20), wRemove(5) {}
+};
+
+class WorkloadGenerator {
+private:
+    WorkloadConfig cfg;
+    uint64_t rng;
+
+    int* active;         // active squad ids (swap-remove array)
+    int activeCount;
+    int activeCap;
+    HashTable<int, int> position;   // squad id -> index in active, -1 if gone
+
+    int nextSquadSeq;    // sequence number fed into the id distribution
+    int nextHunterSeq;
+
+    int setupSquadsLeft;
+    long long setupHuntersLeft;
+    long long mixedLeft;
+
+    int chainForcing;    // current forcing squad id (0 = none)
+    int chainLeft;
+
+    uint64_t next64() {
+        // xorshift64*
+        rng ^= rng >> 12;
+        rng ^= rng << 25;
+        rng ^= rng >> 27;
+        return rng * 2685821657736338717ULL;
+    }
+
+    int below(int n) { return (int)(next64() % (uint64_t)n); }
+
+    int idFor(int seq) {
+        switch (cfg.ids) {
+            case IdDist::SPARSE: {
+                // keep ids distinct: bucket per seq, random offset inside it
+                long long stride = 2147483647LL / ((long long)cfg.squads * 4 + (long long)cfg.ops / 4 + 1);
+                if (stride < 1) stride = 1;
+                long long id = (long long)seq * stride + 1 + (long long)(next64() % (uint64_t)stride);
+                return (int)(id % 2147483647LL) + 1;
+            }
+            case IdDist::RANDOM:
+                return 1 + (int)(next64() % 2147483646ULL);
+            default:
+                return seq;
+        }
+    }
+
+    void addActive(int id) {
+        if (activeCount == activeCap) {
+            int newCap = activeCap ? activeCap * 2 : 1024;
+            int* bigger = new int[newCap];
+            for (int i = 0; i < activeCount; i++) bigger[i] = active[i];
+            delete[] active;
+            active = bigger;
+            activeCap = newCap;
+        }
+        int* pos = position.find(id);
+        if (pos) {
+            if (*pos >= 0) return;   // already tracked
+            *pos = activeCount;
+        } else {
+            (void)position.insert(id, activeCount);
+        }
+        active[activeCount++] = id;
+    }
+
+    int takeActive(int idx) {
+        int id = active[idx];
+        activeCount -= 1;
+        if (idx != activeCount) {
+            active[idx] = active[activeCount];
+            *position.find(active[idx]) = idx;
+        }
+        *position.find(id) = -1;
+        return id;
+    }
+
+    void dropActive(int id) {
+        int* pos = position.find(id);
+        if (pos && *pos >= 0) (void)takeActive(*pos);
+    }
+
+    int randomSquad() { return activeCount ? active[below(activeCount)] : 1; }
+    int randomHunter() { return nextHunterSeq > 1 ? idFor(1 + below(nextHunterSeq - 1)) : 1; }
+
+    void makeAddSquad(Command& c) {
+        c.op = Op::ADD_SQUAD;
+        c.arg[0] = idFor(nextSquadSeq++);
+        addActive(c.arg[0]);
+    }
+
+    void makeAddHunter(Command& c, int squadId) {
+        c.op = Op::ADD_HUNTER;
+        c.arg[0] = idFor(nextHunterSeq++);
+        c.arg[1] = squadId;
+        c.arg[2] = below(1000);    // aura
+        c.arg[3] = below(10);      // fights had
+        c.nen = (unsigned char)below(6);
+    }
+
+public:
+    explicit WorkloadGenerator(const WorkloadConfig& config)
+        : cfg(config), rng(config.seed ? config.seed : 88172645463325252ULL),
+          active(nullptr), activeCount(0), activeCap(0), position(),
+          nextSquadSeq(1), nextHunterSeq(1),
+          setupSquadsLeft(config.squads),
+          setupHuntersLeft((long long)config.squads * config.huntersPerSquad),
+          mixedLeft(config.ops),
+          chainForcing(0), chainLeft(0) {}
+
+    ~WorkloadGenerator() { delete[] active; }
+
+    WorkloadGenerator(const WorkloadGenerator&) = delete;
+    WorkloadGenerator& operator=(const WorkloadGenerator&) = delete;
+
+    bool inSetup() const { return setupSquadsLeft > 0 || setupHuntersLeft > 0; }
+
+    // Outcome of the last command returned by next().
+    void observe(const Command& c, StatusType st) {
+        if (c.op == Op::ADD_SQUAD && st != StatusType::SUCCESS) dropActive(c.arg[0]);
+        else if (c.op == Op::FORCE_JOIN && st == StatusType::SUCCESS) dropActive(c.arg[1]);
+    }
+
+    // Next command, false when the workload is exhausted.
+    bool next(Command& c) {
+        c.nen = 0;
+        c.arg[0] = c.arg[1] = c.arg[2] = c.arg[3] = 0;
+
+        if (setupSquadsLeft > 0) {
+            setupSquadsLeft -= 1;
+            makeAddSquad(c);
+            return true;
+        }
+        if (setupHuntersLeft > 0 && activeCount > 0) {
+            setupHuntersLeft -= 1;
+            // round-robin over the initial squads
+            makeAddHunter(c, active[setupHuntersLeft % activeCount]);
+            return true;
+        }
+        setupHuntersLeft = 0;
+        if (mixedLeft <= 0) return false;
+        mixedLeft -= 1;
+
+        int total = cfg.wDuel + cfg.wJoin + cfg.wQuery + cfg.wAdd + cfg.wRemove;
+        int r = below(total > 0 ? total : 1);
+
+        if ((r -= cfg.wDuel) < 0) {
+            c.op = Op::SQUAD_DUEL;
+            c.arg[0] = randomSquad();
+            c.arg[1] = randomSquad();
+        } else if ((r -= cfg.wJoin) < 0) {
+            if (chainLeft <= 0 || activeCount < 2) {
+                chainForcing = randomSquad();
+                chainLeft = cfg.chainDepth;
+            }
+            chainLeft -= 1;
+            c.op = Op::FORCE_JOIN;
+            c.arg[0] = chainForcing;
+            c.arg[1] = randomSquad();
+        } else if ((r -= cfg.wQuery) < 0) {
+            switch (below(4)) {
+                case 0:
+                    c.op = Op::GET_HUNTER_FIGHTS;
+                    c.arg[0] = randomHunter();
+                    break;
+                case 1:
+                    c.op = Op::GET_PARTIAL_NEN;
+                    c.arg[0] = randomHunter();
+                    break;
+                case 2:
+                    c.op = Op::GET_SQUAD_EXPERIENCE;
+                    c.arg[0] = randomSquad();
+                    break;
+                default:
+                    c.op = Op::GET_ITH_AURA_SQUAD;
+                    c.arg[0] = 1 + below(activeCount ? activeCount : 1);
+                    break;
+            }
+        } else if ((r -= cfg.wAdd) < 0) {
+            if (activeCount < cfg.squads / 2 || activeCount == 0) makeAddSquad(c);
+            else makeAddHunter(c, randomSquad());
+        } else {
+            c.op = Op::REMOVE_SQUAD;
+            c.arg[0] = activeCount ? takeActive(below(activeCount)) : 1;
+        }
+        return true;
+    }
+};
+
+#endif // DS_WET2_WINTER_2026_01_WORKLOADGENERATOR_H
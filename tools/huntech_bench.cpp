@@ -0,0 +1,182 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+// End-to-end Huntech benchmark driven by WorkloadGenerator.
+//
+// Usage: huntech_bench [options]
+//   --ops N                 mixed-phase operations           (default 1000000)
+//   --squads N              initial squads                   (default 10000)
+//   --hunters-per-squad N   initial hunters per squad        (default 10)
+//   --chain-depth N         consecutive joins per forcing squad (default 1)
+//   --ids dense|sparse|random                                (default dense)
+//   --mix D,J,Q,A,R         weights: duel, join, query, add, remove (default 20,5,50,20,5)
+//   --seed N                                                 (default 1)
+//   --json FILE             write the JSON report to FILE    (default stdout)
+//   --emit-log FILE         also record the workload as a binary command log
+//
+// The report holds the configuration, setup/mixed wall time, throughput and
+// per-command count, mean, p50, p99, p99.9 and max latency in nanoseconds.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "CommandExecutor.h"
+#include "CommandLog.h"
+#include "LatencyHistogram.h"
+#include "WorkloadGenerator.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const char* idDistName(IdDist d) {
+    switch (d) {
+        case IdDist::SPARSE: return "sparse";
+        case IdDist::RANDOM: return "random";
+        default: return "dense";
+    }
+}
+
+static int usage() {
+    fprintf(stderr,
+            "usage: huntech_bench [--ops N] [--squads N] [--hunters-per-squad N]\n"
+            "                     [--chain-depth N] [--ids dense|sparse|random]\n"
+            "                     [--mix D,J,Q,A,R] [--seed N] [--json FILE] [--emit-log FILE]\n");
+    return 2;
+}
+
+static bool parseMix(const char* s, WorkloadConfig& cfg) {
+    int w[5];
+    if (sscanf(s, "%d,%d,%d,%d,%d", &w[0], &w[1], &w[2], &w[3], &w[4]) != 5) return false;
+    for (int i = 0; i < 5; i++) if (w[i] < 0) return false;
+    cfg.wDuel = w[0];
+    cfg.wJoin = w[1];
+    cfg.wQuery = w[2];
+    cfg.wAdd = w[3];
+    cfg.wRemove = w[4];
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    WorkloadConfig cfg;
+    const char* jsonPath = nullptr;
+    const char* logPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* v = argv[++i];
+
+        if (strcmp(a, "--ops") == 0) cfg.ops = atoll(v);
+        else if (strcmp(a, "--squads") == 0) cfg.squads = atoi(v);
+        else if (strcmp(a, "--hunters-per-squad") == 0) cfg.huntersPerSquad = atoi(v);
+        else if (strcmp(a, "--chain-depth") == 0) cfg.chainDepth = atoi(v);
+        else if (strcmp(a, "--seed") == 0) cfg.seed = strtoull(v, nullptr, 10);
+        else if (strcmp(a, "--json") == 0) jsonPath = v;
+        else if (strcmp(a, "--emit-log") == 0) logPath = v;
+        else if (strcmp(a, "--mix") == 0) {
+            if (!parseMix(v, cfg)) return usage();
+        } else if (strcmp(a, "--ids") == 0) {
+            if (strcmp(v, "dense") == 0) cfg.ids = IdDist::DENSE;
+            else if (strcmp(v, "sparse") == 0) cfg.ids = IdDist::SPARSE;
+            else if (strcmp(v, "random") == 0) cfg.ids = IdDist::RANDOM;
+            else return usage();
+        } else {
+            return usage();
+        }
+    }
+    if (cfg.ops < 0 || cfg.squads < 0 || cfg.huntersPerSquad < 0 || cfg.chainDepth < 1) return usage();
+
+    CommandLogWriter log;
+    if (logPath && !log.open(logPath)) {
+        fprintf(stderr, "cannot create %s\n", logPath);
+        return 1;
+    }
+
+    static LatencyHistogram hist[OP_COUNT];
+    unsigned long long success[OP_COUNT] = { 0 };
+
+    WorkloadGenerator gen(cfg);
+    Huntech* obj = new Huntech();
+    Command cmd{};
+    Result res{};
+
+    double setupSeconds = 0;
+    long long setupOps = 0;
+    long long mixedOps = 0;
+    Clock::time_point phaseStart = Clock::now();
+    bool setup = true;
+
+    while (true) {
+        bool wasSetup = gen.inSetup();
+        if (setup && !wasSetup) {
+            setupSeconds = std::chrono::duration<double>(Clock::now() - phaseStart).count();
+            phaseStart = Clock::now();
+            setup = false;
+        }
+        if (!gen.next(cmd)) break;
+        if (log.isOpen()) (void)log.append(cmd);
+
+        Clock::time_point t0 = Clock::now();
+        execute(*obj, cmd, res);
+        Clock::time_point t1 = Clock::now();
+
+        hist[(int)cmd.op].record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        if (res.status == StatusType::SUCCESS) success[(int)cmd.op] += 1;
+        gen.observe(cmd, res.status);
+
+        if (wasSetup) setupOps += 1;
+        else mixedOps += 1;
+    }
+    double end = std::chrono::duration<double>(Clock::now() - phaseStart).count();
+    double mixedSeconds = setup ? 0 : end;
+    if (setup) setupSeconds = end;
+
+    Clock::time_point d0 = Clock::now();
+    delete obj;
+    double teardownSeconds = std::chrono::duration<double>(Clock::now() - d0).count();
+
+    if (!log.close()) fprintf(stderr, "error while writing %s\n", logPath);
+
+    FILE* out = stdout;
+    if (jsonPath) {
+        out = fopen(jsonPath, "w");
+        if (!out) {
+            fprintf(stderr, "cannot create %s\n", jsonPath);
+            return 1;
+        }
+    }
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"config\": {\"ops\": %lld, \"squads\": %d, \"hunters_per_squad\": %d, "
+                 "\"chain_depth\": %d, \"ids\": \"%s\", \"seed\": %llu, "
+                 "\"mix\": {\"duel\": %d, \"join\": %d, \"query\": %d, \"add\": %d, \"remove\": %d}},\n",
+            cfg.ops, cfg.squads, cfg.huntersPerSquad, cfg.chainDepth, idDistName(cfg.ids),
+            (unsigned long long)cfg.seed, cfg.wDuel, cfg.wJoin, cfg.wQuery, cfg.wAdd, cfg.wRemove);
+    fprintf(out, "  \"setup\": {\"ops\": %lld, \"seconds\": %.6f, \"ops_per_sec\": %.0f},\n",
+            setupOps, setupSeconds, setupSeconds > 0 ? (double)setupOps / setupSeconds : 0.0);
+    fprintf(out, "  \"mixed\": {\"ops\": %lld, \"seconds\": %.6f, \"ops_per_sec\": %.0f},\n",
+            mixedOps, mixedSeconds, mixedSeconds > 0 ? (double)mixedOps / mixedSeconds : 0.0);
+    fprintf(out, "  \"teardown_seconds\": %.6f,\n", teardownSeconds);
+    fprintf(out, "  \"commands\": {");
+    bool first = true;
+    for (int op = 0; op < OP_COUNT; op++) {
+        const LatencyHistogram& h = hist[op];
+        if (h.count() == 0) continue;
+        fprintf(out, "%s\n    \"%s\": {\"count\": %llu, \"success\": %llu, \"mean_ns\": %.1f, "
+                     "\"p50_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu}",
+                first ? "" : ",", opName((Op)op),
+                (unsigned long long)h.count(), success[op], h.mean(),
+                (unsigned long long)h.percentile(0.50),
+                (unsigned long long)h.percentile(0.99),
+                (unsigned long long)h.percentile(0.999),
+                (unsigned long long)h.max());
+        first = false;
+    }
+    fprintf(out, "\n  }\n}\n");
+
+    if (out != stdout) fclose(out);
+    return 0;
+}
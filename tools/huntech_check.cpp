@@ -0,0 +1,917 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+// Brute-force cross-checks for the Huntech extension API.
+//
+// Usage: huntech_check [--rounds N] [--seed N] [check ...]
+//   --rounds N    random workloads per check                (default 20)
+//   --seed N                                                (default 1)
+//   check         bulk rank range sums peek snap reclaim idmap
+//                 (default: every check)
+//
+// Each check runs random workloads over small id pools, so duplicate ids,
+// missing squads, invalid arguments and joins of joined squads are common,
+// and compares the API under test with an answer computed independently:
+//   bulk     bulk_load vs the same add_squad/add_hunter calls one by one, on
+//            an empty and on a non-empty Huntech, then the same mutations on
+//            both instances
+//   rank     get_squad_aura_rank and count_squads_in_aura_range vs a sorted
+//            copy of the collective auras (the aura model below, itself
+//            checked against get_ith_collective_aura_squad)
+//   range    get_aura_squads_range vs the aura model
+//   sums     get_top_squads_aura_sum and get_aura_band_sum vs sums over the
+//            aura model
+//   peek     peek_* on an instance never queried otherwise (long DSU paths,
+//            compress_paths now and then) vs get_* on a twin instance
+//   snap     take_aura_snapshot views (PersistentAVLTree versions) vs copies
+//            of the aura model made when each one was taken, while the
+//            instance keeps mutating
+//   reclaim  enable_reclamation (switched on mid-run) and periodic
+//            reclaim_dead_sets vs an instance that never frees anything
+//   idmap    IdMap<long long> vs a flag array over a sorted key pool, driven
+//            through direct -> hashed -> direct switches (page spread,
+//            density, negative keys), then random inserts/erases (the odd
+//            rounds of the Huntech checks use sparse ids, so Huntech's own
+//            id maps run hashed there)
+// One line per check goes to stdout, the first mismatches to stderr.
+// Exit status 1 on any mismatch.
+//
+
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../IdMap.h"
+#include "CommandExecutor.h"
+
+namespace {
+
+const int MAX_POOL = 1024;
+const int OPS_PER_ROUND = 1500;
+
+class Rng {
+private:
+    uint64_t s;
+
+public:
+    explicit Rng(uint64_t seed) : s(seed ? seed : 88172645463325252ULL) {}
+
+    uint64_t next64() {
+        // xorshift64*
+        s ^= s >> 12;
+        s ^= s << 25;
+        s ^= s >> 27;
+        return s * 2685821657736338717ULL;
+    }
+
+    int below(int n) { return n > 0 ? (int)(next64() % (uint64_t)n) : 0; }
+};
+
+// Comparison counter of one check; the first mismatches are printed.
+struct Report {
+    const char* check;
+    long long compared;
+    long long mismatches;
+
+    explicit Report(const char* name) : check(name), compared(0), mismatches(0) {}
+
+    void expect(bool ok, const char* what, long long x, long long y) {
+        compared += 1;
+        if (ok) return;
+        if (mismatches < 10) fprintf(stderr, "%s: %s (%lld, %lld)\n", check, what, x, y);
+        mismatches += 1;
+    }
+};
+
+template <typename T>
+void expectSame(Report& rep, const char* what, int arg, output_t<T> x, output_t<T> y) {
+    bool ok = x.status() == y.status() && (x.status() != StatusType::SUCCESS || x.ans() == y.ans());
+    rep.expect(ok, what, arg, (long long)x.status());
+}
+
+// Runs c on h and compares the result with the one a reference instance gave.
+void runAndCompare(Report& rep, Huntech& h, const Command& c, const Result& expected) {
+    Result r{};
+    execute(h, c, r);
+    bool ok = r.status == expected.status;
+    if (ok && r.status == StatusType::SUCCESS) {
+        if (r.kind == RESULT_INT) ok = r.value == expected.value;
+        else if (r.kind == RESULT_NEN) ok = r.nen == expected.nen;
+    }
+    rep.expect(ok, opName(c.op), c.arg[0], c.arg[1]);
+}
+
+// Distinct ids of one workload, ascending: 1..n, or one in each of n equal
+// strides of the positive int range.
+struct IdPool {
+    int id[MAX_POOL];
+    int size;
+
+    void fill(Rng& rng, int n, bool sparse) {
+        long long stride = sparse ? 2147483647LL / n : 1;
+        for (int k = 0; k < n; k++) {
+            id[k] = (int)(k * stride + 1 + (sparse ? rng.below((int)stride) : 0));
+        }
+        size = n;
+    }
+
+    // slot of an id, -1 if it is not in the pool
+    int slotOf(int x) const {
+        int lo = 0;
+        int hi = size - 1;
+        while (lo <= hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (id[mid] == x) return mid;
+            if (id[mid] < x) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        return -1;
+    }
+
+    // a pool id, now and then an invalid one (0 or negative)
+    int pick(Rng& rng) const {
+        int r = rng.below(50);
+        if (r == 0) return 0;
+        if (r == 1) return -id[rng.below(size)];
+        return id[rng.below(size)];
+    }
+};
+
+// Random mutations over a squad pool and a hunter pool (about three hunters
+// per squad). Even rounds use dense ids, odd rounds sparse ones; every
+// fourth round draws auras below 4 so that aura ties are common.
+class Workload {
+private:
+    Rng& rng;
+    int auraRange;
+
+public:
+    IdPool squads;
+    IdPool hunters;
+
+    Workload(Rng& r, int round) : rng(r), auraRange(round % 4 == 3 ? 4 : 1000) {
+        int n = 20 + rng.below(180);
+        squads.fill(rng, n, round % 2 == 1);
+        hunters.fill(rng, 3 * n, round % 2 == 1);
+    }
+
+    void addHunter(Command& c) {
+        c.op = Op::ADD_HUNTER;
+        c.arg[0] = hunters.pick(rng);
+        c.arg[1] = squads.pick(rng);
+        c.arg[2] = rng.below(100) == 0 ? -1 : rng.below(auraRange);
+        c.arg[3] = rng.below(100) == 0 ? -1 : rng.below(10);
+        c.nen = rng.below(100) == 0 ? NEN_INVALID : (unsigned char)rng.below(6);
+    }
+
+    void next(Command& c) {
+        c.nen = 0;
+        c.arg[0] = c.arg[1] = c.arg[2] = c.arg[3] = 0;
+        int r = rng.below(100);
+        if (r < 40) {
+            addHunter(c);
+            return;
+        }
+        if (r < 55) c.op = Op::ADD_SQUAD;
+        else if (r < 75) c.op = Op::SQUAD_DUEL;
+        else if (r < 90) c.op = Op::FORCE_JOIN;
+        else c.op = Op::REMOVE_SQUAD;
+        c.arg[0] = squads.pick(rng);
+        c.arg[1] = squads.pick(rng);
+    }
+};
+
+// Every answer of the wet API on both instances: experience of each pool
+// squad, fights and partial Nen ability of each pool hunter, and the whole
+// collective-aura order.
+void compareAnswers(Report& rep, Huntech& x, Huntech& y, const Workload& w) {
+    for (int k = 0; k < w.squads.size; k++) {
+        int id = w.squads.id[k];
+        expectSame(rep, "get_squad_experience", id, x.get_squad_experience(id), y.get_squad_experience(id));
+    }
+    for (int k = 0; k < w.hunters.size; k++) {
+        int id = w.hunters.id[k];
+        expectSame(rep, "get_hunter_fights_number", id,
+                   x.get_hunter_fights_number(id), y.get_hunter_fights_number(id));
+        expectSame(rep, "get_partial_nen_ability", id,
+                   x.get_partial_nen_ability(id), y.get_partial_nen_ability(id));
+    }
+    for (int i = 1; i <= w.squads.size + 1; i++) {
+        output_t<int> a = x.get_ith_collective_aura_squad(i);
+        expectSame(rep, "get_ith_collective_aura_squad", i, a, y.get_ith_collective_aura_squad(i));
+        if (a.status() != StatusType::SUCCESS) break;
+    }
+}
+
+// ---------- bulk_load ----------
+
+HunterRecord recordOf(const Command& c) {
+    HunterRecord r;
+    r.hunterId = c.arg[0];
+    r.squadId = c.arg[1];
+    r.nenType = nenOfType(c.nen);
+    r.aura = c.arg[2];
+    r.fightsHad = c.arg[3];
+    return r;
+}
+
+// n add_squad ids and m add_hunter rows drawn from the workload; loaded into
+// `bulk` with one bulk_load and into `single` call by call
+void loadBoth(Report& rep, Rng& rng, Workload& w, Huntech& bulk, Huntech& single) {
+    int n = rng.below(2 * w.squads.size);
+    int m = rng.below(2 * w.hunters.size);
+    int* ids = new int[n + 1];
+    HunterRecord* rows = new HunterRecord[m + 1];
+    Command c{};
+
+    int done = 0;
+    for (int k = 0; k < n; k++) {
+        ids[k] = w.squads.pick(rng);
+        if (single.add_squad(ids[k]) == StatusType::SUCCESS) done++;
+    }
+    for (int k = 0; k < m; k++) {
+        w.addHunter(c);
+        rows[k] = recordOf(c);
+        if (single.add_hunter(c.arg[0], c.arg[1], nenOfType(c.nen), c.arg[2], c.arg[3]) == StatusType::SUCCESS) {
+            done++;
+        }
+    }
+
+    output_t<int> loaded = bulk.bulk_load(ids, n, rows, m);
+    rep.expect(loaded.status() == StatusType::SUCCESS, "bulk_load status", (long long)loaded.status(), 0);
+    rep.expect(loaded.ans() == done, "bulk_load count", loaded.ans(), done);
+
+    delete[] ids;
+    delete[] rows;
+}
+
+void checkBulk(Report& rep, Rng& rng, int rounds) {
+    for (int round = 0; round < rounds; round++) {
+        Workload w(rng, round);
+        Huntech bulk;
+        Huntech single;
+
+        loadBoth(rep, rng, w, bulk, single);    // empty Huntech: sorted path
+        compareAnswers(rep, bulk, single, w);
+        loadBoth(rep, rng, w, bulk, single);    // non-empty: call by call
+        compareAnswers(rep, bulk, single, w);
+
+        Command c{};
+        Result r{};
+        for (int op = 0; op < OPS_PER_ROUND; op++) {
+            w.next(c);
+            execute(single, c, r);
+            runAndCompare(rep, bulk, c, r);
+            if (op % 256 == 255) compareAnswers(rep, bulk, single, w);
+        }
+        compareAnswers(rep, bulk, single, w);
+    }
+
+    Huntech h;
+    int id = 1;
+    rep.expect(h.bulk_load(&id, -1, nullptr, 0).status() == StatusType::INVALID_INPUT, "bulk_load count < 0", 0, 0);
+    rep.expect(h.bulk_load(nullptr, 1, nullptr, 0).status() == StatusType::INVALID_INPUT, "bulk_load null ids", 0, 0);
+}
+
+// ---------- collective-aura checks ----------
+
+// Collective aura of each pool squad, kept by hand from the statuses
+// Huntech returned: add_hunter adds the hunter's aura to its squad,
+// force_join moves the forced squad's aura to the forcing one, remove_squad
+// drops the squad.
+class AuraModel {
+private:
+    const IdPool& squads;
+    bool active[MAX_POOL];
+    long long aura[MAX_POOL];
+
+    static int compareKeys(const void* a, const void* b) {
+        AuraKeyLess less;
+        const AuraKey& x = *(const AuraKey*)a;
+        const AuraKey& y = *(const AuraKey*)b;
+        return less(x, y) ? -1 : (less(y, x) ? 1 : 0);
+    }
+
+public:
+    explicit AuraModel(const IdPool& pool) : squads(pool) {
+        for (int k = 0; k < MAX_POOL; k++) {
+            active[k] = false;
+            aura[k] = 0;
+        }
+    }
+
+    void applied(const Command& c, StatusType st) {
+        if (st != StatusType::SUCCESS) return;
+        switch (c.op) {
+            case Op::ADD_SQUAD: {
+                int k = squads.slotOf(c.arg[0]);
+                active[k] = true;
+                aura[k] = 0;
+                break;
+            }
+            case Op::REMOVE_SQUAD:
+                active[squads.slotOf(c.arg[0])] = false;
+                break;
+            case Op::ADD_HUNTER:
+                aura[squads.slotOf(c.arg[1])] += c.arg[2];
+                break;
+            case Op::FORCE_JOIN: {
+                int forced = squads.slotOf(c.arg[1]);
+                aura[squads.slotOf(c.arg[0])] += aura[forced];
+                active[forced] = false;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    bool isActive(int squadId) const {
+        int k = squads.slotOf(squadId);
+        return k >= 0 && active[k];
+    }
+
+    // active squads in collective-aura order; returns their number
+    int order(AuraKey* out) const {
+        int n = 0;
+        for (int k = 0; k < squads.size; k++) {
+            if (active[k]) out[n++] = AuraKey(aura[k], squads.id[k]);
+        }
+        qsort(out, n, sizeof(AuraKey), compareKeys);
+        return n;
+    }
+
+    long long countIn(long long lo, long long hi) const {
+        long long n = 0;
+        for (int k = 0; k < squads.size; k++) {
+            if (active[k] && lo <= aura[k] && aura[k] <= hi) n++;
+        }
+        return n;
+    }
+
+    long long sumIn(long long lo, long long hi) const {
+        long long sum = 0;
+        for (int k = 0; k < squads.size; k++) {
+            if (active[k] && lo <= aura[k] && aura[k] <= hi) sum += aura[k];
+        }
+        return sum;
+    }
+};
+
+// Base of the checks driven by runAuraWorkloads: a check adds
+// step(h, w, model, keys, n, op) and, if it holds state tied to the
+// workload's Huntech, end().
+struct AuraCheck {
+    Report& rep;
+    Rng& rng;
+
+    AuraCheck(Report& r, Rng& g) : rep(r), rng(g) {}
+
+    // the workload's Huntech is about to be destroyed
+    void end() {}
+};
+
+// Runs `rounds` random workloads on a Huntech and its AuraModel. On every
+// fourth operation the model order keys[0..n-1] is checked against
+// get_ith_collective_aura_squad and handed to check.step().
+template <typename Check>
+void runAuraWorkloads(Check& check, int rounds) {
+    AuraKey* keys = new AuraKey[MAX_POOL];
+
+    for (int round = 0; round < rounds; round++) {
+        Workload w(check.rng, round);
+        AuraModel model(w.squads);
+        Huntech h;
+        Command c{};
+        Result r{};
+
+        for (int op = 0; op < OPS_PER_ROUND; op++) {
+            w.next(c);
+            execute(h, c, r);
+            model.applied(c, r.status);
+            if (op % 4 != 3) continue;
+
+            int n = model.order(keys);
+            for (int i = 1; i <= n; i++) {
+                output_t<int> ith = h.get_ith_collective_aura_squad(i);
+                check.rep.expect(ith.status() == StatusType::SUCCESS && ith.ans() == keys[i - 1].squadId,
+                                 "get_ith_collective_aura_squad", i, keys[i - 1].squadId);
+            }
+            check.rep.expect(h.get_ith_collective_aura_squad(n + 1).status() == StatusType::FAILURE,
+                             "get_ith_collective_aura_squad past the end", n + 1, 0);
+            check.step(h, w, model, keys, n, op);
+        }
+        check.end();
+    }
+    delete[] keys;
+}
+
+// A query bound: mostly next to an existing collective aura (ties and
+// off-by-one edges), sometimes arbitrary or an extreme value.
+long long auraBound(Rng& rng, const AuraKey* keys, int n) {
+    int r = rng.below(16);
+    if (r == 0) return LLONG_MIN;
+    if (r == 1) return LLONG_MAX;
+    if (r < 5 || n == 0) return rng.below(4000) - 500;
+    return keys[rng.below(n)].aura + rng.below(3) - 1;
+}
+
+// ---------- get_squad_aura_rank, count_squads_in_aura_range ----------
+
+struct RankCheck : AuraCheck {
+    RankCheck(Report& r, Rng& g) : AuraCheck(r, g) {}
+
+    void step(Huntech& h, const Workload& w, const AuraModel& model, const AuraKey* keys, int n, int) {
+        for (int i = 1; i <= n; i++) {
+            output_t<int> rank = h.get_squad_aura_rank(keys[i - 1].squadId);
+            rep.expect(rank.status() == StatusType::SUCCESS && rank.ans() == i,
+                       "get_squad_aura_rank", keys[i - 1].squadId, i);
+        }
+        int other = w.squads.id[rng.below(w.squads.size)];
+        if (!model.isActive(other)) {
+            rep.expect(h.get_squad_aura_rank(other).status() == StatusType::FAILURE,
+                       "get_squad_aura_rank of an inactive squad", other, 0);
+        }
+        rep.expect(h.get_squad_aura_rank(0).status() == StatusType::INVALID_INPUT,
+                   "get_squad_aura_rank(0)", 0, 0);
+
+        for (int q = 0; q < 4; q++) {
+            long long lo = auraBound(rng, keys, n);
+            long long hi = auraBound(rng, keys, n);
+            if (lo > hi) {
+                rep.expect(h.count_squads_in_aura_range(lo, hi).status() == StatusType::INVALID_INPUT,
+                           "count_squads_in_aura_range min > max", lo, hi);
+                long long t = lo;
+                lo = hi;
+                hi = t;
+            }
+            output_t<int> count = h.count_squads_in_aura_range(lo, hi);
+            rep.expect(count.status() == StatusType::SUCCESS && count.ans() == model.countIn(lo, hi),
+                       "count_squads_in_aura_range", lo, hi);
+        }
+    }
+};
+
+void checkRank(Report& rep, Rng& rng, int rounds) {
+    RankCheck check(rep, rng);
+    runAuraWorkloads(check, rounds);
+}
+
+// ---------- get_aura_squads_range ----------
+
+struct RangeCheck : AuraCheck {
+    int out[MAX_POOL + 1];
+
+    RangeCheck(Report& r, Rng& g) : AuraCheck(r, g) {}
+
+    void step(Huntech& h, const Workload&, const AuraModel&, const AuraKey* keys, int n, int) {
+        for (int q = 0; q < 4 && n > 0; q++) {
+            int i = 1 + rng.below(n);
+            int j = (q == 0) ? n : i + rng.below(n - i + 1);
+            if (q == 1) i = 1;
+            out[j - i + 1] = -1;    // must stay untouched
+            output_t<int> got = h.get_aura_squads_range(i, j, out);
+            bool ok = got.status() == StatusType::SUCCESS && got.ans() == j - i + 1 && out[j - i + 1] == -1;
+            for (int k = i; ok && k <= j; k++) ok = out[k - i] == keys[k - 1].squadId;
+            rep.expect(ok, "get_aura_squads_range", i, j);
+        }
+        rep.expect(h.get_aura_squads_range(1, n + 1, out).status() == StatusType::FAILURE,
+                   "get_aura_squads_range past the end", 1, n + 1);
+        rep.expect(h.get_aura_squads_range(0, n, out).status() == StatusType::INVALID_INPUT,
+                   "get_aura_squads_range i < 1", 0, n);
+        rep.expect(h.get_aura_squads_range(2, 1, out).status() == StatusType::INVALID_INPUT,
+                   "get_aura_squads_range j < i", 2, 1);
+        rep.expect(h.get_aura_squads_range(1, 1, nullptr).status() == StatusType::INVALID_INPUT,
+                   "get_aura_squads_range null out", 1, 1);
+    }
+};
+
+void checkRange(Report& rep, Rng& rng, int rounds) {
+    RangeCheck* check = new RangeCheck(rep, rng);
+    runAuraWorkloads(*check, rounds);
+    delete check;
+}
+
+// ---------- get_top_squads_aura_sum, get_aura_band_sum ----------
+
+struct SumsCheck : AuraCheck {
+    SumsCheck(Report& r, Rng& g) : AuraCheck(r, g) {}
+
+    void step(Huntech& h, const Workload&, const AuraModel& model, const AuraKey* keys, int n, int) {
+        long long top = 0;
+        for (int k = 1; k <= n; k++) {
+            top += keys[n - k].aura;
+            output_t<long long> sum = h.get_top_squads_aura_sum(k);
+            rep.expect(sum.status() == StatusType::SUCCESS && sum.ans() == top,
+                       "get_top_squads_aura_sum", k, top);
+        }
+        rep.expect(h.get_top_squads_aura_sum(n + 1).status() == StatusType::FAILURE,
+                   "get_top_squads_aura_sum k > size", n + 1, 0);
+        rep.expect(h.get_top_squads_aura_sum(0).status() == StatusType::INVALID_INPUT,
+                   "get_top_squads_aura_sum(0)", 0, 0);
+
+        for (int q = 0; q < 4; q++) {
+            long long lo = auraBound(rng, keys, n);
+            long long hi = auraBound(rng, keys, n);
+            if (lo > hi) {
+                rep.expect(h.get_aura_band_sum(lo, hi).status() == StatusType::INVALID_INPUT,
+                           "get_aura_band_sum min > max", lo, hi);
+                long long t = lo;
+                lo = hi;
+                hi = t;
+            }
+            output_t<long long> sum = h.get_aura_band_sum(lo, hi);
+            rep.expect(sum.status() == StatusType::SUCCESS && sum.ans() == model.sumIn(lo, hi),
+                       "get_aura_band_sum", lo, hi);
+        }
+    }
+};
+
+void checkSums(Report& rep, Rng& rng, int rounds) {
+    SumsCheck check(rep, rng);
+    runAuraWorkloads(check, rounds);
+}
+
+// ---------- peek_* ----------
+
+void checkPeek(Report& rep, Rng& rng, int rounds) {
+    for (int round = 0; round < rounds; round++) {
+        Workload w(rng, round);
+        Huntech peeked;
+        Huntech ref;
+        Command c{};
+        Result r{};
+
+        for (int op = 0; op < OPS_PER_ROUND; op++) {
+            w.next(c);
+            execute(ref, c, r);
+            runAndCompare(rep, peeked, c, r);
+            if (op % 300 == 299) peeked.compress_paths();
+            if (op % 8 != 7) continue;
+
+            const Huntech& view = peeked;
+            for (int k = 0; k < w.squads.size; k++) {
+                int id = w.squads.id[k];
+                expectSame(rep, "peek_squad_experience", id,
+                           view.peek_squad_experience(id), ref.get_squad_experience(id));
+            }
+            for (int k = 0; k < w.hunters.size; k++) {
+                int id = w.hunters.id[k];
+                expectSame(rep, "peek_hunter_fights_number", id,
+                           view.peek_hunter_fights_number(id), ref.get_hunter_fights_number(id));
+                expectSame(rep, "peek_partial_nen_ability", id,
+                           view.peek_partial_nen_ability(id), ref.get_partial_nen_ability(id));
+            }
+            for (int i = 0; i <= w.squads.size + 1; i++) {
+                output_t<int> a = view.peek_ith_collective_aura_squad(i);
+                expectSame(rep, "peek_ith_collective_aura_squad", i, a, ref.get_ith_collective_aura_squad(i));
+                if (i > 0 && a.status() != StatusType::SUCCESS) break;
+            }
+            expectSame(rep, "peek_squad_experience", 0,
+                       view.peek_squad_experience(0), ref.get_squad_experience(0));
+            expectSame(rep, "peek_hunter_fights_number", -1,
+                       view.peek_hunter_fights_number(-1), ref.get_hunter_fights_number(-1));
+        }
+    }
+}
+
+// ---------- take_aura_snapshot ----------
+
+// node type of Huntech::AuraSnapshot::select
+typedef PersistentAVLTree<AuraKey, int, AuraKeyLess>::Node SnapshotNode;
+
+// Up to LIVE views held across operations, each with the model order of the
+// moment it was taken. Snapshots are enabled at a random step of each
+// workload, so the O(n) rebuild runs on a populated instance.
+struct SnapCheck : AuraCheck {
+    static const int LIVE = 4;
+
+    Huntech::AuraSnapshot snaps[LIVE];
+    AuraKey taken[LIVE][MAX_POOL];
+    int takenSize[LIVE];
+    bool enabled;
+    int enableAt;
+
+    SnapCheck(Report& r, Rng& g) : AuraCheck(r, g), enabled(false), enableAt(rng.below(300)) {}
+
+    void expectView(const Huntech::AuraSnapshot& snap, const AuraKey* keys, int n) {
+        rep.expect(snap.valid() && snap.size() == n, "snapshot size", snap.size(), n);
+        for (int i = 1; i <= n; i++) {
+            const AuraKey& k = keys[i - 1];
+            const SnapshotNode* node = snap.select(i);
+            bool ok = node && node->key.aura == k.aura && node->key.squadId == k.squadId && node->value == k.squadId;
+            rep.expect(ok, "snapshot select", i, k.squadId);
+            rep.expect(snap.rank(k) == i, "snapshot rank", k.squadId, i);
+            rep.expect(snap.countLess(k) == i - 1, "snapshot countLess", k.squadId, i - 1);
+        }
+        rep.expect(snap.select(n + 1) == nullptr, "snapshot select past the end", n + 1, 0);
+
+        int seen = 0;
+        bool inOrder = true;
+        snap.forEachInOrder([&](const AuraKey& k, int) {
+            if (seen >= n || keys[seen].squadId != k.squadId || keys[seen].aura != k.aura) inOrder = false;
+            seen++;
+        });
+        rep.expect(inOrder && seen == n, "snapshot forEachInOrder", seen, n);
+    }
+
+    void step(Huntech& h, const Workload&, const AuraModel&, const AuraKey* keys, int n, int op) {
+        if (!enabled) {
+            Huntech::AuraSnapshot none;
+            rep.expect(h.take_aura_snapshot(none) == StatusType::FAILURE, "take_aura_snapshot before enable", op, 0);
+            if (op < enableAt) return;
+            rep.expect(h.enable_aura_snapshots() == StatusType::SUCCESS, "enable_aura_snapshots", op, 0);
+            enabled = true;
+        }
+
+        int slot = rng.below(LIVE);
+        int what = rng.below(8);
+        if (what < 3) {
+            rep.expect(h.take_aura_snapshot(snaps[slot]) == StatusType::SUCCESS, "take_aura_snapshot", op, 0);
+            for (int i = 0; i < n; i++) taken[slot][i] = keys[i];
+            takenSize[slot] = n;
+        } else if (what == 3) {
+            snaps[slot].release();
+            rep.expect(!snaps[slot].valid() && snaps[slot].size() == 0, "released snapshot", slot, 0);
+        }
+        for (int k = 0; k < LIVE; k++) {
+            if (snaps[k].valid()) expectView(snaps[k], taken[k], takenSize[k]);
+        }
+    }
+
+    // every view goes back before the Huntech is destroyed
+    void end() {
+        for (int k = 0; k < LIVE; k++) snaps[k].release();
+        enabled = false;
+        enableAt = rng.below(300);
+    }
+};
+
+void checkSnap(Report& rep, Rng& rng, int rounds) {
+    SnapCheck* check = new SnapCheck(rep, rng);
+    runAuraWorkloads(*check, rounds);
+    delete check;
+}
+
+// ---------- enable_reclamation, reclaim_dead_sets ----------
+
+void checkReclaim(Report& rep, Rng& rng, int rounds) {
+    for (int round = 0; round < rounds; round++) {
+        Workload w(rng, round);
+        Huntech ref;
+        Huntech eager;      // enable_reclamation at enableAt
+        Huntech compact;    // reclaim_dead_sets every 200 operations
+        Command c{};
+        Result r{};
+
+        int enableAt = rng.below(OPS_PER_ROUND / 2);
+        long long freed = 0;
+        for (int op = 0; op < OPS_PER_ROUND; op++) {
+            if (op == enableAt) {
+                eager.enable_reclamation();
+                output_t<int> n = eager.reclaim_dead_sets();
+                rep.expect(n.status() == StatusType::SUCCESS && n.ans() >= 0, "reclaim_dead_sets", op, n.ans());
+            }
+            if (op % 200 == 199) {
+                output_t<int> n = compact.reclaim_dead_sets();
+                rep.expect(n.status() == StatusType::SUCCESS && n.ans() >= 0, "reclaim_dead_sets", op, n.ans());
+                freed += n.ans();
+            }
+            w.next(c);
+            execute(ref, c, r);
+            runAndCompare(rep, eager, c, r);
+            runAndCompare(rep, compact, c, r);
+            if (op % 64 == 63) {
+                compareAnswers(rep, eager, ref, w);
+                compareAnswers(rep, compact, ref, w);
+            }
+        }
+        rep.expect(freed > 0, "reclaim_dead_sets freed nothing", round, freed);
+        compareAnswers(rep, eager, ref, w);
+        compareAnswers(rep, compact, ref, w);
+    }
+}
+
+// ---------- IdMap ----------
+
+// The keys an IdMap may hold in one round, ascending, with the expected
+// content: dense keys [0, DENSE), a few negatives and large keys up to
+// INT_MAX, INT_MIN included.
+class KeyModel {
+private:
+    static const int DENSE = 70000;
+    static const int EXTRA = 64;
+
+    static int compareInts(const void* a, const void* b) {
+        int x = *(const int*)a;
+        int y = *(const int*)b;
+        return x < y ? -1 : (x > y ? 1 : 0);
+    }
+
+public:
+    int* key;
+    bool* present;
+    long long* value;
+    int* seen;       // forEach visits of the current pass
+    int size;
+    int count;
+
+    explicit KeyModel(Rng& rng) : count(0) {
+        int cap = DENSE + 2 * EXTRA + 2;
+        key = new int[cap];
+        int n = 0;
+        for (int k = 0; k < DENSE; k++) key[n++] = k;
+        for (int k = 0; k < EXTRA; k++) key[n++] = -1 - rng.below(1000000);
+        for (int k = 0; k < EXTRA; k++) key[n++] = DENSE + rng.below(2147483647 - DENSE);
+        key[n++] = INT_MIN;
+        key[n++] = INT_MAX;
+        qsort(key, n, sizeof(int), compareInts);
+        size = 0;
+        for (int k = 0; k < n; k++) {
+            if (size == 0 || key[size - 1] != key[k]) key[size++] = key[k];
+        }
+        present = new bool[size];
+        value = new long long[size];
+        seen = new int[size];
+        for (int k = 0; k < size; k++) {
+            present[k] = false;
+            value[k] = 0;
+        }
+    }
+
+    ~KeyModel() {
+        delete[] key;
+        delete[] present;
+        delete[] value;
+        delete[] seen;
+    }
+
+    KeyModel(const KeyModel&) = delete;
+    KeyModel& operator=(const KeyModel&) = delete;
+
+    int slotOf(int x) const {
+        int lo = 0;
+        int hi = size - 1;
+        while (lo <= hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (key[mid] == x) return mid;
+            if (key[mid] < x) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        return -1;
+    }
+};
+
+void insertBoth(Report& rep, IdMap<long long>& map, KeyModel& model, int k, long long v) {
+    bool inserted = map.insert(model.key[k], v);
+    rep.expect(inserted == !model.present[k], "IdMap insert", model.key[k], inserted);
+    if (inserted) {
+        model.present[k] = true;
+        model.value[k] = v;
+        model.count += 1;
+    }
+}
+
+void eraseBoth(Report& rep, IdMap<long long>& map, KeyModel& model, int k) {
+    bool erased = map.erase(model.key[k]);
+    rep.expect(erased == model.present[k], "IdMap erase", model.key[k], erased);
+    if (erased) {
+        model.present[k] = false;
+        model.count -= 1;
+    }
+}
+
+void compareMap(Report& rep, const IdMap<long long>& map, KeyModel& model) {
+    rep.expect(map.size() == model.count, "IdMap size", map.size(), model.count);
+    for (int k = 0; k < model.size; k++) {
+        const long long* v = map.find(model.key[k]);
+        bool ok = model.present[k] ? (v && *v == model.value[k]) : !v;
+        rep.expect(ok, "IdMap find", model.key[k], model.present[k]);
+        model.seen[k] = 0;
+    }
+    int visits = 0;
+    bool ok = true;
+    map.forEach([&](int key, const long long& v) {
+        int k = model.slotOf(key);
+        if (k < 0 || !model.present[k] || model.value[k] != v || model.seen[k]++ != 0) ok = false;
+        visits++;
+    });
+    rep.expect(ok && visits == model.count, "IdMap forEach", visits, model.count);
+}
+
+void checkIdMap(Report& rep, Rng& rng, int rounds) {
+    for (int round = 0; round < rounds; round++) {
+        KeyModel model(rng);
+        IdMap<long long> map;
+        const int zero = model.slotOf(0);
+        const long long tag = (long long)round << 40;
+
+        // one key per 1024, i.e. a new page each time: goes hashed
+        for (int p = 0; p < 64; p++) insertBoth(rep, map, model, zero + p * 1024 + rng.below(1024), tag + p);
+        rep.expect(!map.isDirect(), "IdMap hashed after page spread", map.size(), 0);
+        compareMap(rep, map, model);
+
+        // dense keys below the spread ones: back to direct
+        for (int k = 0; k < 60000; k++) insertBoth(rep, map, model, zero + rng.below(70000), tag + k);
+        rep.expect(map.isDirect(), "IdMap direct once dense", map.size(), 0);
+        compareMap(rep, map, model);
+
+        // a negative key forces hashed, erasing it lets the next insert
+        // switch back
+        int negative = rng.below(zero);
+        insertBoth(rep, map, model, negative, tag - 1);
+        rep.expect(!map.isDirect(), "IdMap hashed with a negative key", model.key[negative], 0);
+        compareMap(rep, map, model);
+        eraseBoth(rep, map, model, negative);
+        for (int k = 0; k < 100; k++) insertBoth(rep, map, model, zero + rng.below(70000), tag + k);
+        rep.expect(map.isDirect(), "IdMap direct again", map.size(), 0);
+
+        // values written through find() stick in either layout
+        for (int k = 0; k < 1000; k++) {
+            int slot = zero + rng.below(70000);
+            long long* v = map.find(model.key[slot]);
+            rep.expect((v != nullptr) == model.present[slot], "IdMap find", model.key[slot], model.present[slot]);
+            if (v) *v = model.value[slot] = tag + 7 * k;
+        }
+        compareMap(rep, map, model);
+
+        // random inserts/erases over the whole pool, erasing more than
+        // inserting so the map thins out again
+        for (int op = 0; op < 200000; op++) {
+            int slot = rng.below(model.size);
+            if (rng.below(8) < 3) insertBoth(rep, map, model, slot, tag + op);
+            else eraseBoth(rep, map, model, slot);
+            if (op % 25000 == 24999) compareMap(rep, map, model);
+        }
+        compareMap(rep, map, model);
+
+        map.clear();
+        rep.expect(map.isDirect() && map.isEmpty(), "IdMap clear", map.size(), 0);
+        rep.expect(map.insert(5, 5) && *map.find(5) == 5, "IdMap insert after clear", 5, 0);
+    }
+}
+
+struct NamedCheck {
+    const char* name;
+    void (*run)(Report&, Rng&, int);
+};
+
+const NamedCheck CHECKS[] = {
+    { "bulk", checkBulk },
+    { "rank", checkRank },
+    { "range", checkRange },
+    { "sums", checkSums },
+    { "peek", checkPeek },
+    { "snap", checkSnap },
+    { "reclaim", checkReclaim },
+    { "idmap", checkIdMap }
+};
+const int CHECK_COUNT = (int)(sizeof(CHECKS) / sizeof(CHECKS[0]));
+
+int usage() {
+    fprintf(stderr, "usage: huntech_check [--rounds N] [--seed N] [check ...]\n  checks:");
+    for (int k = 0; k < CHECK_COUNT; k++) fprintf(stderr, " %s", CHECKS[k].name);
+    fprintf(stderr, "\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int rounds = 20;
+    uint64_t seed = 1;
+    bool selected[CHECK_COUNT] = { false };
+    bool any = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (strcmp(a, "--rounds") == 0 || strcmp(a, "--seed") == 0) {
+            if (i + 1 >= argc) return usage();
+            const char* v = argv[++i];
+            if (a[2] == 'r') rounds = atoi(v);
+            else seed = strtoull(v, nullptr, 10);
+            continue;
+        }
+        int k = 0;
+        while (k < CHECK_COUNT && strcmp(a, CHECKS[k].name) != 0) k++;
+        if (k == CHECK_COUNT) return usage();
+        selected[k] = true;
+        any = true;
+    }
+    if (rounds < 1) return usage();
+
+    bool failed = false;
+    for (int k = 0; k < CHECK_COUNT; k++) {
+        if (any && !selected[k]) continue;
+        Rng rng(seed);
+        Report rep(CHECKS[k].name);
+        CHECKS[k].run(rep, rng, rounds);
+        printf("%s: %s (%lld comparisons, %lld mismatches)\n",
+               rep.check, rep.mismatches ? "FAILED" : "ok", rep.compared, rep.mismatches);
+        if (rep.mismatches) failed = true;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,161 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+// Binary command log utility (format in CommandLog.h).
+//
+// Usage:
+//   huntech_log convert <commands.txt> <commands.bin>
+//       text command language -> binary log (up to and including the
+//       first malformed command, as far as the text drivers execute)
+//   huntech_log replay <commands.bin> [--print] [--no-op-timing]
+//       feeds the records straight into Huntech and reports ops/sec per
+//       command type on stderr; --print also writes the usual result lines
+//       to stdout, --no-op-timing only measures the whole run
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "CommandLog.h"
+#include "OutputBuffer.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static int usage() {
+    fprintf(stderr,
+            "usage: huntech_log convert <commands.txt> <commands.bin>\n"
+            "       huntech_log replay <commands.bin> [--print] [--no-op-timing]\n");
+    return 2;
+}
+
+static int convert(const char* inPath, const char* outPath) {
+    int fd = open(inPath, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "cannot open %s\n", inPath);
+        return 1;
+    }
+    InputBuffer input;
+    bool loaded = input.load(fd);
+    close(fd);
+    if (!loaded) {
+        fprintf(stderr, "failed to read %s\n", inPath);
+        return 1;
+    }
+
+    CommandLogWriter log;
+    if (!log.open(outPath)) {
+        fprintf(stderr, "cannot create %s\n", outPath);
+        return 1;
+    }
+
+    CommandParser parser(input.begin(), input.end());
+    Command cmd{};
+    Token opToken;
+    while (true) {
+        CommandParser::Status st = parser.next(cmd, opToken);
+        if (st == CommandParser::END) break;
+        if (st == CommandParser::UNKNOWN_OP) {
+            fprintf(stderr, "stopping at unknown command: %.*s\n", opToken.n, opToken.p);
+            break;
+        }
+        if (!log.append(cmd)) {
+            fprintf(stderr, "write error on %s\n", outPath);
+            return 1;
+        }
+        if (st == CommandParser::BAD_FORMAT) {
+            // kept: the text drivers still execute it, then stop
+            fprintf(stderr, "stopping after malformed %s command\n", opName(cmd.op));
+            break;
+        }
+    }
+
+    uint64_t n = log.count();
+    if (!log.close()) {
+        fprintf(stderr, "write error on %s\n", outPath);
+        return 1;
+    }
+    fprintf(stderr, "wrote %llu records\n", (unsigned long long)n);
+    return 0;
+}
+
+static int replay(const char* path, bool print, bool opTiming) {
+    CommandLogReader log;
+    const char* err = log.open(path);
+    if (err) {
+        fprintf(stderr, "%s: %s\n", path, err);
+        return 1;
+    }
+
+    unsigned long long calls[OP_COUNT] = { 0 };
+    long long nanos[OP_COUNT] = { 0 };
+
+    Huntech* obj = new Huntech();
+    OutputBuffer out(1);
+    Command cmd{};
+    Result res{};
+
+    uint64_t n = log.count();
+    Clock::time_point start = Clock::now();
+    for (uint64_t i = 0; i < n; i++) {
+        fromRecord(log.at(i), cmd);
+        int op = (int)cmd.op;
+        calls[op] += 1;
+
+        if (opTiming) {
+            Clock::time_point t0 = Clock::now();
+            execute(*obj, cmd, res);
+            nanos[op] += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+        } else {
+            execute(*obj, cmd, res);
+        }
+
+        if (print) out.result(res);
+    }
+    double wall = std::chrono::duration<double>(Clock::now() - start).count();
+    out.flush();
+    delete obj;
+
+#ifdef HUNTECH_STATS
+    huntechStatsDump(stderr);
+#endif
+
+    fprintf(stderr, "%-26s %12s %12s %14s\n", "command", "count", "ns/op", "ops/sec");
+    if (opTiming) {
+        for (int op = 0; op < OP_COUNT; op++) {
+            if (calls[op] == 0) continue;
+            double ns = (double)nanos[op] / (double)calls[op];
+            fprintf(stderr, "%-26s %12llu %12.1f %14.0f\n",
+                    opName((Op)op), calls[op], ns, ns > 0 ? 1e9 / ns : 0.0);
+        }
+    }
+    fprintf(stderr, "%-26s %12llu %12.1f %14.0f\n", "TOTAL (wall)",
+            (unsigned long long)n, n ? wall * 1e9 / (double)n : 0.0, wall > 0 ? (double)n / wall : 0.0);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) return usage();
+
+    if (strcmp(argv[1], "convert") == 0) {
+        if (argc != 4) return usage();
+        return convert(argv[2], argv[3]);
+    }
+
+    if (strcmp(argv[1], "replay") == 0) {
+        bool print = false;
+        bool opTiming = true;
+        for (int i = 3; i < argc; i++) {
+            if (strcmp(argv[i], "--print") == 0) print = true;
+            else if (strcmp(argv[i], "--no-op-timing") == 0) opTiming = false;
+            else return usage();
+        }
+        return replay(argv[2], print, opTiming);
+    }
+
+    return usage();
+}
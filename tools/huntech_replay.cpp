@@ -0,0 +1,176 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+// Production replay driver: same command language and byte-identical output
+// as main26a2.cpp, but with a zero-copy parser (see CommandParser.h) and a
+// buffered formatter that writes only when its buffer fills (OutputBuffer.h).
+//
+// Usage: huntech_replay [--record <log.bin>] [--load-snapshot <snap>]
+//                       [--save-snapshot <snap>] [--pipeline] [--shards N]
+//                       [--reclaim] [input-file]
+//   reads stdin when no file is given; --record also captures every executed
+//   command into a binary log (CommandLog.h) for later max-speed replay;
+//   --load-snapshot starts from a saved state instead of an empty one and
+//   --save-snapshot writes the final state (HuntechSnapshot.cpp);
+//   --pipeline parses, executes and formats on three threads connected by
+//   lock-free rings (CommandPipeline.h), with the same output;
+//   --shards N partitions the squads over N Huntech instances, each on its
+//   own worker thread (ShardedHuntech.h), with the same output; it cannot be
+//   combined with the snapshot options;
+//   --reclaim frees the squads and hunters of removed squads and reuses
+//   their memory (Huntech::enable_reclamation), with the same output
+//
+// Built with -DHUNTECH_STATS, the instrumentation snapshot (HuntechStats.h)
+// is printed to stderr on SIGUSR1 and at the end of the run.
+//
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+
+#include "CommandLog.h"
+#include "CommandPipeline.h"
+#include "OutputBuffer.h"
+#include "ShardedHuntech.h"
+
+using namespace std;
+
+#ifdef HUNTECH_STATS
+static volatile sig_atomic_t statsRequested = 0;
+
+static void onStatsSignal(int) {
+    statsRequested = 1;
+}
+#endif
+
+static void pollStats() {
+#ifdef HUNTECH_STATS
+    if (statsRequested) {
+        statsRequested = 0;
+        huntechStatsDump(stderr);
+    }
+#endif
+}
+
+int main(int argc, char** argv)
+{
+    const char* inPath = nullptr;
+    const char* loadPath = nullptr;
+    const char* savePath = nullptr;
+    bool pipeline = false;
+    int shards = 0;
+    bool reclaim = false;
+    CommandLogWriter recorder;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            if (!recorder.open(argv[++i])) {
+                cerr << "cannot create " << argv[i] << endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--load-snapshot") == 0 && i + 1 < argc) {
+            loadPath = argv[++i];
+        } else if (strcmp(argv[i], "--save-snapshot") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (strcmp(argv[i], "--pipeline") == 0) {
+            pipeline = true;
+        } else if (strcmp(argv[i], "--reclaim") == 0) {
+            reclaim = true;
+        } else if (strcmp(argv[i], "--shards") == 0 && i + 1 < argc) {
+            shards = atoi(argv[++i]);
+            if (shards < 1) {
+                cerr << "--shards needs a positive count" << endl;
+                return 1;
+            }
+        } else {
+            inPath = argv[i];
+        }
+    }
+
+    if (shards > 0 && (loadPath || savePath)) {
+        cerr << "--shards cannot be combined with snapshots" << endl;
+        return 1;
+    }
+
+    int fd = 0;
+    if (inPath) {
+        fd = open(inPath, O_RDONLY);
+        if (fd < 0) {
+            cerr << "cannot open " << inPath << endl;
+            return 1;
+        }
+    }
+
+    InputBuffer input;
+    if (!input.load(fd)) {
+        cerr << "failed to read input" << endl;
+        return 1;
+    }
+
+#ifdef HUNTECH_STATS
+    signal(SIGUSR1, onStatsSignal);
+#endif
+
+    if (shards > 0) {
+        CommandParser parser(input.begin(), input.end());
+        OutputBuffer out(1);
+        ShardedHuntech sharded(shards, reclaim);
+        sharded.run(parser, out, recorder);
+        if (!recorder.close()) cerr << "error while writing the command log" << endl;
+        if (fd > 0) close(fd);
+        return 0;
+    }
+
+    Huntech* obj = new Huntech();
+    if (loadPath && obj->load_snapshot(loadPath) != StatusType::SUCCESS) {
+        cerr << "cannot load snapshot " << loadPath << endl;
+        delete obj;
+        return 1;
+    }
+    if (reclaim) obj->enable_reclamation();
+    CommandParser parser(input.begin(), input.end());
+    OutputBuffer out(1);
+
+    if (pipeline) {
+        runPipelined(*obj, parser, out, recorder, pollStats);
+    } else {
+        Command cmd{};
+        Result res{};
+        Token opToken;
+        while (true) {
+            CommandParser::Status st = parser.next(cmd, opToken);
+            if (st == CommandParser::END) break;
+
+            if (st == CommandParser::UNKNOWN_OP) {
+                out.line("Unknown command: ", opToken.p, opToken.n);
+                break;
+            }
+
+            // a malformed command still runs (missing arguments read as 0)
+            if (recorder.isOpen()) (void)recorder.append(cmd);
+
+            execute(*obj, cmd, res);
+            out.result(res);
+            pollStats();
+
+            // Verify no faults
+            if (st == CommandParser::BAD_FORMAT) {
+                out.line("Invalid input format", "", 0);
+                break;
+            }
+        }
+    }
+
+    out.flush();
+    if (savePath && obj->save_snapshot(savePath) != StatusType::SUCCESS) {
+        cerr << "cannot save snapshot " << savePath << endl;
+    }
+#ifdef HUNTECH_STATS
+    huntechStatsDump(stderr);
+#endif
+    if (!recorder.close()) cerr << "error while writing the command log" << endl;
+    delete obj;
+    if (fd > 0) close(fd);
+    return 0;
+}
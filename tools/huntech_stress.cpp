@@ -0,0 +1,289 @@
+//
+// Created by khaled-sawaid on 11/01/2026.
+//
+// Multi-threaded stress test and read-scaling benchmark for the concurrent
+// mode (ConcurrentHuntech.h).
+//
+// Usage: huntech_stress [options]
+//   --readers N             reader threads                   (default 4)
+//   --ops N                 writer mixed-phase mutations     (default 200000)
+//   --squads N              initial squads                   (default 2000)
+//   --hunters-per-squad N   initial hunters per squad        (default 10)
+//   --reads N               queries per reader and phase     (default 200000)
+//   --compress-every N      writer compress_paths() period, 0 = never (default 4096)
+//   --seed N                                                 (default 1)
+//
+// 1) check: one writer applies a WorkloadGenerator mutation stream while the
+//    readers issue random queries; every answer is kept with its version.
+//    A single-threaded reference Huntech then replays the writes and checks
+//    each answer against the regular API at that version. Exit status 1 on
+//    any mismatch.
+// 2) scaling: read-only throughput on the final state with 1, 2, 4, ...
+//    readers threads.
+// The JSON report is written to stdout.
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "ConcurrentHuntech.h"
+#include "WorkloadGenerator.h"
+
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+
+struct ReadRecord {
+    Command cmd{};
+    Result res{};
+    unsigned long long version;
+};
+
+// Random queries over the id ranges the writer can produce (dense ids).
+class QueryGenerator {
+private:
+    uint64_t rng;
+    int maxSquad;
+    int maxHunter;
+
+    uint64_t next64() {
+        rng ^= rng >> 12;
+        rng ^= rng << 25;
+        rng ^= rng >> 27;
+        return rng * 2685821657736338717ULL;
+    }
+
+    int upTo(int n) { return 1 + (int)(next64() % (uint64_t)(n > 0 ? n : 1)); }
+
+public:
+    QueryGenerator(uint64_t seed, int squads, int hunters)
+        : rng(seed ? seed : 88172645463325252ULL), maxSquad(squads), maxHunter(hunters) {}
+
+    void next(Command& c) {
+        c.nen = 0;
+        c.arg[1] = c.arg[2] = c.arg[3] = 0;
+        switch (next64() % 4) {
+            case 0:
+                c.op = Op::GET_HUNTER_FIGHTS;
+                c.arg[0] = upTo(maxHunter);
+                break;
+            case 1:
+                c.op = Op::GET_SQUAD_EXPERIENCE;
+                c.arg[0] = upTo(maxSquad);
+                break;
+            case 2:
+                c.op = Op::GET_ITH_AURA_SQUAD;
+                c.arg[0] = upTo(maxSquad);
+                break;
+            default:
+                c.op = Op::GET_PARTIAL_NEN;
+                c.arg[0] = upTo(maxHunter);
+                break;
+        }
+    }
+};
+
+bool sameResult(const Result& a, const Result& b) {
+    if (a.status != b.status || a.kind != b.kind) return false;
+    if (a.status != StatusType::SUCCESS) return true;
+    if (a.kind == RESULT_INT) return a.value == b.value;
+    if (a.kind == RESULT_NEN) {
+        NenVec x = NenVec::fromAbility(a.nen);
+        NenVec y = NenVec::fromAbility(b.nen);
+        return memcmp(x.c, y.c, sizeof(x.c)) == 0;
+    }
+    return true;
+}
+
+int usage() {
+    fprintf(stderr,
+            "usage: huntech_stress [--readers N] [--ops N] [--squads N] [--hunters-per-squad N]\n"
+            "                      [--reads N] [--compress-every N] [--seed N]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    WorkloadConfig cfg;
+    cfg.ops = 200000;
+    cfg.squads = 2000;
+    cfg.wQuery = 0;   // the writer only mutates
+    int readers = 4;
+    long long reads = 200000;
+    int compressEvery = 4096;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (i + 1 >= argc) return usage();
+        const char* v = argv[++i];
+
+        if (strcmp(a, "--readers") == 0) readers = atoi(v);
+        else if (strcmp(a, "--ops") == 0) cfg.ops = atoll(v);
+        else if (strcmp(a, "--squads") == 0) cfg.squads = atoi(v);
+        else if (strcmp(a, "--hunters-per-squad") == 0) cfg.huntersPerSquad = atoi(v);
+        else if (strcmp(a, "--reads") == 0) reads = atoll(v);
+        else if (strcmp(a, "--compress-every") == 0) compressEvery = atoi(v);
+        else if (strcmp(a, "--seed") == 0) cfg.seed = strtoull(v, nullptr, 10);
+        else return usage();
+    }
+    if (readers < 1 || cfg.ops < 0 || cfg.squads < 0 || cfg.huntersPerSquad < 0 ||
+        reads < 1 || compressEvery < 0) {
+        return usage();
+    }
+
+    const long long totalWrites = (long long)cfg.squads + (long long)cfg.squads * cfg.huntersPerSquad + cfg.ops;
+    const int maxSquad = (int)((long long)cfg.squads + cfg.ops / 8 + 1);
+    const int maxHunter = (int)((long long)cfg.squads * cfg.huntersPerSquad + cfg.ops / 4 + 1);
+
+    // ---- 1) writer + readers, every answer kept with its version ----
+    ConcurrentHuntech shared(compressEvery);
+    Command* writeLog = new Command[totalWrites > 0 ? totalWrites : 1];
+    long long written = 0;
+
+    ReadRecord** records = new ReadRecord*[readers];
+    long long* recorded = new long long[readers];
+    for (int t = 0; t < readers; t++) {
+        records[t] = new ReadRecord[reads];
+        recorded[t] = 0;
+    }
+
+    std::atomic<bool> writerDone(false);
+    std::atomic<int> ready(0);
+
+    std::thread* threads = new std::thread[readers];
+    for (int t = 0; t < readers; t++) {
+        threads[t] = std::thread([&, t]() {
+            QueryGenerator q(cfg.seed * 1000003ULL + (uint64_t)t + 1, maxSquad, maxHunter);
+            ReadRecord* mine = records[t];
+            ready.fetch_add(1);
+            long long n = 0;
+            while (n < reads && !writerDone.load(std::memory_order_acquire)) {
+                q.next(mine[n].cmd);
+                shared.read(mine[n].cmd, mine[n].res, &mine[n].version);
+                n++;
+            }
+            recorded[t] = n;
+        });
+    }
+    while (ready.load() < readers) std::this_thread::yield();
+
+    Clock::time_point w0 = Clock::now();
+    {
+        WorkloadGenerator gen(cfg);
+        Command cmd{};
+        Result res{};
+        while (written < totalWrites && gen.next(cmd)) {
+            shared.write(cmd, res);
+            gen.observe(cmd, res.status);
+            writeLog[written++] = cmd;
+        }
+    }
+    double writeSeconds = std::chrono::duration<double>(Clock::now() - w0).count();
+    writerDone.store(true, std::memory_order_release);
+    for (int t = 0; t < readers; t++) threads[t].join();
+
+    // ---- check against a single-threaded replay ----
+    long long checkedReads = 0;
+    for (int t = 0; t < readers; t++) checkedReads += recorded[t];
+
+    // counting sort of all records by version
+    long long* firstAt = new long long[written + 2];
+    for (long long v = 0; v <= written + 1; v++) firstAt[v] = 0;
+    for (int t = 0; t < readers; t++) {
+        for (long long i = 0; i < recorded[t]; i++) firstAt[records[t][i].version + 1] += 1;
+    }
+    for (long long v = 1; v <= written + 1; v++) firstAt[v] += firstAt[v - 1];
+    const ReadRecord** byVersion = new const ReadRecord*[checkedReads > 0 ? checkedReads : 1];
+    {
+        long long* fill = new long long[written + 1];
+        for (long long v = 0; v <= written; v++) fill[v] = firstAt[v];
+        for (int t = 0; t < readers; t++) {
+            for (long long i = 0; i < recorded[t]; i++) {
+                byVersion[fill[records[t][i].version]++] = &records[t][i];
+            }
+        }
+        delete[] fill;
+    }
+
+    long long versionsSeen = 0;
+    for (long long v = 0; v <= written; v++) {
+        if (firstAt[v + 1] > firstAt[v]) versionsSeen += 1;
+    }
+
+    long long mismatches = 0;
+    {
+        Huntech* ref = new Huntech();
+        Result expect;
+        for (long long v = 0; v <= written; v++) {
+            for (long long k = firstAt[v]; k < firstAt[v + 1]; k++) {
+                execute(*ref, byVersion[k]->cmd, expect);
+                if (!sameResult(expect, byVersion[k]->res)) {
+                    if (mismatches < 10) {
+                        fprintf(stderr, "mismatch at version %lld: %s %d\n",
+                                v, opName(byVersion[k]->cmd.op), byVersion[k]->cmd.arg[0]);
+                    }
+                    mismatches += 1;
+                }
+            }
+            if (v < written) execute(*ref, writeLog[v], expect);
+        }
+        delete ref;
+    }
+    delete[] byVersion;
+    delete[] firstAt;
+
+    // ---- 2) read-only scaling on the final state ----
+    fprintf(stdout, "{\n");
+    fprintf(stdout, "  \"config\": {\"readers\": %d, \"ops\": %lld, \"squads\": %d, "
+                    "\"hunters_per_squad\": %d, \"reads\": %lld, \"compress_every\": %d, "
+                    "\"seed\": %llu, \"hardware_threads\": %u},\n",
+            readers, cfg.ops, cfg.squads, cfg.huntersPerSquad, reads, compressEvery,
+            (unsigned long long)cfg.seed, std::thread::hardware_concurrency());
+    fprintf(stdout, "  \"check\": {\"writes\": %lld, \"write_seconds\": %.6f, "
+                    "\"reads\": %lld, \"versions_seen\": %lld, \"mismatches\": %lld},\n",
+            written, writeSeconds, checkedReads, versionsSeen, mismatches);
+    fprintf(stdout, "  \"scaling\": [");
+
+    bool first = true;
+    for (int n = 1; ; n = (n * 2 < readers) ? n * 2 : readers) {
+        std::atomic<int> go(0);
+        ready.store(0);
+        for (int t = 0; t < n; t++) {
+            threads[t] = std::thread([&, t]() {
+                QueryGenerator q(cfg.seed * 7919ULL + (uint64_t)t + 1, maxSquad, maxHunter);
+                Command c{};
+                Result r;
+                ready.fetch_add(1);
+                while (go.load(std::memory_order_acquire) == 0) std::this_thread::yield();
+                for (long long i = 0; i < reads; i++) {
+                    q.next(c);
+                    shared.read(c, r);
+                }
+            });
+        }
+        while (ready.load() < n) std::this_thread::yield();
+        Clock::time_point s0 = Clock::now();
+        go.store(1, std::memory_order_release);
+        for (int t = 0; t < n; t++) threads[t].join();
+        double seconds = std::chrono::duration<double>(Clock::now() - s0).count();
+
+        fprintf(stdout, "%s\n    {\"threads\": %d, \"seconds\": %.6f, \"reads_per_sec\": %.0f}",
+                first ? "" : ",", n, seconds, seconds > 0 ? (double)n * (double)reads / seconds : 0.0);
+        first = false;
+        if (n >= readers) break;
+    }
+    fprintf(stdout, "\n  ]\n}\n");
+
+    delete[] threads;
+    for (int t = 0; t < readers; t++) delete[] records[t];
+    delete[] records;
+    delete[] recorded;
+    delete[] writeLog;
+    return mismatches == 0 ? 0 : 1;
+}